@@ -26,6 +26,7 @@
 #include "brave/components/brave_shields/browser/ad_block_regional_service_manager.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "brave/components/brave_shields/browser/https_everywhere_service.h"
+#include "brave/components/brave_shields/browser/query_string_filter_service.h"
 #include "brave/components/brave_shields/browser/tracking_protection_service.h"
 #include "brave/components/brave_sync/buildflags/buildflags.h"
 #include "brave/components/brave_sync/network_time_helper.h"
@@ -166,6 +167,15 @@ void BraveBrowserProcessImpl::Init() {
   InitSystemRequestHandlerCallback();
 }
 
+void BraveBrowserProcessImpl::StartTearDown() {
+  // Local state is committed for the last time in
+  // BrowserProcessImpl::StartTearDown(), so P3A must flush its pending log
+  // changes before that.
+  if (brave_p3a_service_)
+    brave_p3a_service_->StartTeardown();
+  BrowserProcessImpl::StartTearDown();
+}
+
 brave_component_updater::BraveComponent::Delegate*
 BraveBrowserProcessImpl::brave_component_updater_delegate() {
   if (!brave_component_updater_delegate_)
@@ -192,6 +202,7 @@ void BraveBrowserProcessImpl::StartBraveServices() {
   extension_whitelist_service();
 #endif
   tracking_protection_service();
+  query_string_filter_service();
 #if BUILDFLAG(ENABLE_GREASELION)
   greaselion_download_service();
 #endif
@@ -281,6 +292,16 @@ BraveBrowserProcessImpl::tracking_protection_service() {
   return tracking_protection_service_.get();
 }
 
+brave_shields::QueryStringFilterService*
+BraveBrowserProcessImpl::query_string_filter_service() {
+  if (!query_string_filter_service_) {
+    query_string_filter_service_ =
+        brave_shields::QueryStringFilterServiceFactory(
+            local_data_files_service());
+  }
+  return query_string_filter_service_.get();
+}
+
 brave_shields::HTTPSEverywhereService*
 BraveBrowserProcessImpl::https_everywhere_service() {
   if (!https_everywhere_service_)
@@ -41,6 +41,7 @@ class AdBlockService;
 class AdBlockCustomFiltersService;
 class AdBlockRegionalServiceManager;
 class HTTPSEverywhereService;
+class QueryStringFilterService;
 class TrackingProtectionService;
 }  // namespace brave_shields
 
@@ -89,6 +90,7 @@ class BraveBrowserProcessImpl : public BrowserProcessImpl {
   greaselion::GreaselionDownloadService* greaselion_download_service();
 #endif
   brave_shields::TrackingProtectionService* tracking_protection_service();
+  brave_shields::QueryStringFilterService* query_string_filter_service();
   brave_shields::HTTPSEverywhereService* https_everywhere_service();
   brave_component_updater::LocalDataFilesService* local_data_files_service();
 #if BUILDFLAG(ENABLE_TOR)
@@ -111,6 +113,7 @@ class BraveBrowserProcessImpl : public BrowserProcessImpl {
  private:
   // BrowserProcessImpl overrides:
   void Init() override;
+  void StartTearDown() override;
 
   void CreateProfileManager();
   void CreateNotificationPlatformBridge();
@@ -142,6 +145,8 @@ class BraveBrowserProcessImpl : public BrowserProcessImpl {
 #endif
   std::unique_ptr<brave_shields::TrackingProtectionService>
       tracking_protection_service_;
+  std::unique_ptr<brave_shields::QueryStringFilterService>
+      query_string_filter_service_;
   std::unique_ptr<brave_shields::HTTPSEverywhereService>
       https_everywhere_service_;
   std::unique_ptr<brave::BraveStatsUpdater> brave_stats_updater_;
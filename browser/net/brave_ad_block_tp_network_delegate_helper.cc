@@ -7,14 +7,15 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 
 #include "base/base64url.h"
+#include "base/metrics/histogram_macros.h"
 #include "base/strings/string_util.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/browser/net/url_context.h"
 #include "brave/common/network_constants.h"
-#include "brave/components/brave_shields/browser/ad_block_custom_filters_service.h"
-#include "brave/components/brave_shields/browser/ad_block_regional_service_manager.h"
+#include "brave/components/brave_shields/browser/ad_block_request_matcher.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
 #include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
@@ -26,44 +27,46 @@
 
 namespace brave {
 
-void ShouldBlockAdOnTaskRunner(std::shared_ptr<BraveRequestInfo> ctx) {
-  bool did_match_exception = false;
-  std::string tab_host = ctx->tab_origin.host();
-  if (!g_brave_browser_process->ad_block_service()->ShouldStartRequest(
-          ctx->request_url, ctx->resource_type, tab_host,
-          &did_match_exception, &ctx->cancel_request_explicitly,
-          &ctx->mock_data_url)) {
-    ctx->blocked_by = kAdBlocked;
-  } else if (!did_match_exception &&
-             !g_brave_browser_process->ad_block_regional_service_manager()
-                  ->ShouldStartRequest(ctx->request_url, ctx->resource_type,
-                                       tab_host, &did_match_exception,
-                                       &ctx->cancel_request_explicitly,
-                                       &ctx->mock_data_url)) {
-    ctx->blocked_by = kAdBlocked;
-  } else if (!did_match_exception &&
-             !g_brave_browser_process->ad_block_custom_filters_service()
-                  ->ShouldStartRequest(ctx->request_url, ctx->resource_type,
-                                       tab_host, &did_match_exception,
-                                       &ctx->cancel_request_explicitly,
-                                       &ctx->mock_data_url)) {
+namespace {
+
+void ApplyMatchResult(BraveRequestInfo* ctx,
+                      brave_shields::AdBlockMatchResult* result) {
+  if (result->did_match_rule) {
     ctx->blocked_by = kAdBlocked;
+    ctx->cancel_request_explicitly = result->cancel_request_explicitly;
+    ctx->mock_data_url = std::move(result->mock_data_url);
   }
 }
 
-void OnShouldBlockAdResult(const ResponseCallback& next_callback,
-                           std::shared_ptr<BraveRequestInfo> ctx) {
-  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
-  if (ctx->blocked_by == kAdBlocked) {
+void DispatchAdBlockedEventIfBlocked(const BraveRequestInfo& ctx) {
+  if (ctx.blocked_by == kAdBlocked) {
     brave_shields::DispatchBlockedEvent(
-        ctx->request_url,
-        ctx->render_frame_id, ctx->render_process_id, ctx->frame_tree_node_id,
+        ctx.request_url,
+        ctx.render_frame_id, ctx.render_process_id, ctx.frame_tree_node_id,
         brave_shields::kAds);
   }
+}
+
+}  // namespace
+
+void ShouldBlockAdOnTaskRunner(std::shared_ptr<BraveRequestInfo> ctx,
+                               const brave_shields::AdBlockRequest& request) {
+  brave_shields::AdBlockMatchResult result;
+  g_brave_browser_process->ad_block_service()->MatchAllEngines(request,
+                                                               &result);
+  ApplyMatchResult(ctx.get(), &result);
+}
+
+void OnShouldBlockAdResult(const ResponseCallback& next_callback,
+                           std::shared_ptr<BraveRequestInfo> ctx) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  DispatchAdBlockedEventIfBlocked(*ctx);
   next_callback.Run();
 }
 
-void OnBeforeURLRequestAdBlockTP(
+// Returns true if the decision was made synchronously, in which case
+// |next_callback| is not run.
+bool OnBeforeURLRequestAdBlockTP(
     const ResponseCallback& next_callback,
     std::shared_ptr<BraveRequestInfo> ctx) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
@@ -71,15 +74,34 @@ void OnBeforeURLRequestAdBlockTP(
   // be looked up, so do nothing.
   if (ctx->tab_origin.is_empty() || !ctx->tab_origin.has_host() ||
       ctx->request_url.is_empty()) {
-    return;
+    return true;
   }
   DCHECK_NE(ctx->request_identifier, 0UL);
 
+  brave_shields::AdBlockRequest request(ctx->request_url, ctx->resource_type,
+                                        ctx->tab_origin.host());
+
+  // Repeated requests have usually been answered by every engine already, in
+  // which case there's no need to hop to the ad-block task runner and back.
+  brave_shields::AdBlockMatchResult result;
+  bool inline_decision =
+      g_brave_browser_process->ad_block_service()->MatchAllEnginesFromCache(
+          request, &result);
+  UMA_HISTOGRAM_BOOLEAN("Brave.Shields.AdBlockInlineDecision",
+                        inline_decision);
+  if (inline_decision) {
+    ApplyMatchResult(ctx.get(), &result);
+    DispatchAdBlockedEventIfBlocked(*ctx);
+    return true;
+  }
+
   g_brave_browser_process->ad_block_service()->GetTaskRunner()
       ->PostTaskAndReply(FROM_HERE,
-                         base::BindOnce(&ShouldBlockAdOnTaskRunner, ctx),
-                         base::BindOnce(&OnShouldBlockAdResult, next_callback,
-                                        ctx));
+                         base::BindOnce(&ShouldBlockAdOnTaskRunner, ctx,
+                                        request),
+                         base::BindOnce(&OnShouldBlockAdResult,
+                                        next_callback, ctx));
+  return false;
 }
 
 int OnBeforeURLRequest_AdBlockTPPreWork(
@@ -98,7 +120,9 @@ int OnBeforeURLRequest_AdBlockTPPreWork(
     return net::OK;
   }
 
-  OnBeforeURLRequestAdBlockTP(next_callback, ctx);
+  if (OnBeforeURLRequestAdBlockTP(next_callback, ctx)) {
+    return net::OK;
+  }
 
   return net::ERR_IO_PENDING;
 }
@@ -7,22 +7,15 @@
 
 #include <memory>
 #include <string>
-#include <vector>
 
 #include "base/command_line.h"
 #include "base/feature_list.h"
 #include "base/strings/string_split.h"
 #include "base/strings/string_util.h"
+#include "brave/browser/net/brave_static_redirect_rules.h"
 #include "brave/common/network_constants.h"
 #include "brave/components/brave_component_updater/browser/features.h"
 #include "brave/components/brave_component_updater/browser/switches.h"
-#include "components/component_updater/component_updater_url_constants.h"
-#include "extensions/buildflags/buildflags.h"
-#include "extensions/common/url_pattern.h"
-
-#if BUILDFLAG(ENABLE_EXTENSIONS)
-#include "extensions/common/extension_urls.h"
-#endif
 
 namespace brave {
 
@@ -46,27 +39,6 @@ std::string GetUpdateURLHost() {
   return UPDATER_DEV_ENDPOINT;
 }
 
-// Update server checks happen from the profile context for admin policy
-// installed extensions. Update server checks happen from the system context for
-// normal update operations.
-bool IsUpdaterURL(const GURL& gurl) {
-  static std::vector<URLPattern> updater_patterns(
-      {URLPattern(URLPattern::SCHEME_HTTPS,
-                  std::string(component_updater::kUpdaterJSONDefaultUrl) + "*"),
-       URLPattern(
-           URLPattern::SCHEME_HTTP,
-           std::string(component_updater::kUpdaterJSONFallbackUrl) + "*"),
-#if BUILDFLAG(ENABLE_EXTENSIONS)
-       URLPattern(
-           URLPattern::SCHEME_HTTPS,
-           std::string(extension_urls::kChromeWebstoreUpdateURL) + "*")
-#endif
-  });
-  return std::any_of(
-      updater_patterns.begin(), updater_patterns.end(),
-      [&gurl](URLPattern pattern) { return pattern.MatchesURL(gurl); });
-}
-
 bool RewriteBugReportingURL(const GURL& request_url, GURL* new_url) {
   GURL url("https://github.com/brave/brave-browser/issues/new");
   std::string query = "title=Crash%20Report&labels=crash";
@@ -114,41 +86,37 @@ int OnBeforeURLRequest_CommonStaticRedirectWorkForGURL(
     GURL* new_url) {
   DCHECK(new_url);
 
-  GURL::Replacements replacements;
-  static URLPattern chromecast_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kChromeCastPrefix);
-  static URLPattern clients4_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kClients4Prefix);
-  static URLPattern bugsChromium_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS,
-      "*://bugs.chromium.org/p/chromium/issues/entry?*");
-
-  if (IsUpdaterURL(request_url)) {
-    auto update_host = GetUpdateURLHost();
-    if (!update_host.empty()) {
-      replacements.SetQueryStr(request_url.query_piece());
-      *new_url = GURL(update_host).ReplaceComponents(replacements);
-    }
+  base::Optional<CommonStaticRedirectRule> rule =
+      MatchCommonStaticRedirectRule(request_url);
+  if (!rule)
     return net::OK;
-  }
 
-  if (chromecast_pattern.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr(kBraveRedirectorProxy);
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (clients4_pattern.MatchesHost(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr(kBraveClients4Proxy);
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
+  GURL::Replacements replacements;
+  switch (*rule) {
+    case CommonStaticRedirectRule::kUpdater: {
+      auto update_host = GetUpdateURLHost();
+      if (!update_host.empty()) {
+        replacements.SetQueryStr(request_url.query_piece());
+        *new_url = GURL(update_host).ReplaceComponents(replacements);
+      }
+      break;
+    }
 
-  if (bugsChromium_pattern.MatchesURL(request_url)) {
-    if (RewriteBugReportingURL(request_url, new_url))
-      return net::OK;
+    case CommonStaticRedirectRule::kChromeCast:
+      replacements.SetSchemeStr("https");
+      replacements.SetHostStr(kBraveRedirectorProxy);
+      *new_url = request_url.ReplaceComponents(replacements);
+      break;
+
+    case CommonStaticRedirectRule::kClients4:
+      replacements.SetSchemeStr("https");
+      replacements.SetHostStr(kBraveClients4Proxy);
+      *new_url = request_url.ReplaceComponents(replacements);
+      break;
+
+    case CommonStaticRedirectRule::kBugsChromium:
+      RewriteBugReportingURL(request_url, new_url);
+      break;
   }
 
   return net::OK;
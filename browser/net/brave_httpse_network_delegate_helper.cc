@@ -95,4 +95,9 @@ int OnBeforeURLRequest_HttpsePreFileWork(
   return net::OK;
 }
 
+void OnURLRequestDestroyed_HttpseWork(std::shared_ptr<BraveRequestInfo> ctx) {
+  g_brave_browser_process->https_everywhere_service()->OnURLRequestDestroyed(
+      ctx->request_identifier);
+}
+
 }  // namespace brave
@@ -8,8 +8,11 @@
 #include <algorithm>
 #include <utility>
 
+#include "base/metrics/histogram_functions.h"
 #include "base/metrics/histogram_macros.h"
+#include "base/stl_util.h"
 #include "base/task/post_task.h"
+#include "base/time/time.h"
 #include "brave/browser/net/brave_ad_block_tp_network_delegate_helper.h"
 #include "brave/browser/net/brave_common_static_redirect_network_delegate_helper.h"
 #include "brave/browser/net/brave_httpse_network_delegate_helper.h"
@@ -17,6 +20,7 @@
 #include "brave/browser/net/brave_stp_util.h"
 #include "brave/browser/translate/buildflags/buildflags.h"
 #include "brave/common/pref_names.h"
+#include "brave/common/url_constants.h"
 #include "brave/components/brave_referrals/buildflags/buildflags.h"
 #include "brave/components/brave_rewards/browser/buildflags/buildflags.h"
 #include "brave/components/brave_webtorrent/browser/buildflags/buildflags.h"
@@ -27,6 +31,7 @@
 #include "content/public/browser/browser_thread.h"
 #include "content/public/common/url_constants.h"
 #include "extensions/common/constants.h"
+#include "url/url_constants.h"
 
 #if BUILDFLAG(ENABLE_BRAVE_REFERRALS)
 #include "brave/browser/net/brave_referrals_network_delegate_helper.h"
@@ -44,6 +49,67 @@
 #include "brave/browser/net/brave_translate_redirect_network_delegate_helper.h"
 #endif
 
+namespace brave {
+
+namespace {
+
+const char* const kBeforeURLRequestStageHistograms[] = {
+    "Brave.OnBeforeURLRequest.SiteHacks",
+    "Brave.OnBeforeURLRequest.AdBlockTP",
+    "Brave.OnBeforeURLRequest.Httpse",
+    "Brave.OnBeforeURLRequest.CommonStaticRedirect",
+    "Brave.OnBeforeURLRequest.Rewards",
+    "Brave.OnBeforeURLRequest.TranslateRedirect",
+};
+static_assert(base::size(kBeforeURLRequestStageHistograms) ==
+                  kBeforeURLRequestStageCount,
+              "Every stage needs a histogram");
+
+bool IsFrameRequest(const BraveRequestInfo& ctx) {
+  return ctx.resource_type == blink::mojom::ResourceType::kMainFrame ||
+         ctx.resource_type == blink::mojom::ResourceType::kSubFrame;
+}
+
+}  // namespace
+
+// Each check mirrors the early returns of the corresponding stage, so a
+// stage is only skipped when it would have returned net::OK untouched.
+uint32_t SelectBeforeURLRequestStages(const BraveRequestInfo& ctx) {
+  uint32_t stages = 1u << kCommonStaticRedirectStage;
+
+  // Referrer blocking and the query string filter.
+  if (ctx.request_url.has_query() ||
+      (!ctx.allow_referrers && ctx.allow_brave_shields &&
+       !ctx.referrer.is_empty() && !IsFrameRequest(ctx) &&
+       !ctx.tab_origin.SchemeIs(kChromeExtensionScheme))) {
+    stages |= 1u << kSiteHacksStage;
+  }
+
+  if (!ctx.request_url.is_empty() && !ctx.tab_origin.is_empty() &&
+      ctx.allow_brave_shields && !ctx.allow_ads &&
+      ctx.resource_type != BraveRequestInfo::kInvalidResourceType) {
+    stages |= 1u << kAdBlockTPStage;
+  }
+
+  if (!ctx.tab_origin.is_empty() && !ctx.allow_http_upgradable_resource &&
+      ctx.allow_brave_shields && ctx.request_url.is_valid() &&
+      ctx.request_url.SchemeIsHTTPOrHTTPS()) {
+    stages |= 1u << kHttpseStage;
+  }
+
+  // Only requests with upload data are reported to rewards.
+  if (!ctx.upload_data.empty())
+    stages |= 1u << kRewardsStage;
+
+  // All of the translate patterns are https.
+  if (ctx.request_url.SchemeIs(url::kHttpsScheme))
+    stages |= 1u << kTranslateRedirectStage;
+
+  return stages;
+}
+
+}  // namespace brave
+
 static bool IsInternalScheme(std::shared_ptr<brave::BraveRequestInfo> ctx) {
   DCHECK(ctx);
   return ctx->request_url.SchemeIs(extensions::kExtensionScheme) ||
@@ -59,29 +125,35 @@ BraveRequestHandler::BraveRequestHandler() {
 
 BraveRequestHandler::~BraveRequestHandler() = default;
 
-void BraveRequestHandler::SetupCallbacks() {
-  brave::OnBeforeURLRequestCallback callback =
-      base::Bind(brave::OnBeforeURLRequest_SiteHacksWork);
-  before_url_request_callbacks_.push_back(callback);
-
-  callback = base::Bind(brave::OnBeforeURLRequest_AdBlockTPPreWork);
-  before_url_request_callbacks_.push_back(callback);
-
-  callback = base::Bind(brave::OnBeforeURLRequest_HttpsePreFileWork);
-  before_url_request_callbacks_.push_back(callback);
+void BraveRequestHandler::AddBeforeURLRequestCallback(
+    brave::BeforeURLRequestStage stage,
+    brave::OnBeforeURLRequestCallback callback) {
+  before_url_request_callbacks_.push_back({stage, std::move(callback)});
+}
 
-  callback = base::Bind(brave::OnBeforeURLRequest_CommonStaticRedirectWork);
-  before_url_request_callbacks_.push_back(callback);
+void BraveRequestHandler::SetupCallbacks() {
+  AddBeforeURLRequestCallback(
+      brave::kSiteHacksStage,
+      base::Bind(brave::OnBeforeURLRequest_SiteHacksWork));
+  AddBeforeURLRequestCallback(
+      brave::kAdBlockTPStage,
+      base::Bind(brave::OnBeforeURLRequest_AdBlockTPPreWork));
+  AddBeforeURLRequestCallback(
+      brave::kHttpseStage,
+      base::Bind(brave::OnBeforeURLRequest_HttpsePreFileWork));
+  AddBeforeURLRequestCallback(
+      brave::kCommonStaticRedirectStage,
+      base::Bind(brave::OnBeforeURLRequest_CommonStaticRedirectWork));
 
 #if BUILDFLAG(BRAVE_REWARDS_ENABLED)
-  callback = base::Bind(brave_rewards::OnBeforeURLRequest);
-  before_url_request_callbacks_.push_back(callback);
+  AddBeforeURLRequestCallback(brave::kRewardsStage,
+                              base::Bind(brave_rewards::OnBeforeURLRequest));
 #endif
 
 #if BUILDFLAG(ENABLE_BRAVE_TRANSLATE_GO)
-  callback =
-      base::BindRepeating(brave::OnBeforeURLRequest_TranslateRedirectWork);
-  before_url_request_callbacks_.push_back(callback);
+  AddBeforeURLRequestCallback(
+      brave::kTranslateRedirectStage,
+      base::BindRepeating(brave::OnBeforeURLRequest_TranslateRedirectWork));
 #endif
 
   brave::OnBeforeStartTransactionCallback start_transaction_callback =
@@ -136,9 +208,10 @@ int BraveRequestHandler::OnBeforeURLRequest(
   if (before_url_request_callbacks_.empty() || IsInternalScheme(ctx)) {
     return net::OK;
   }
-  SCOPED_UMA_HISTOGRAM_TIMER("Brave.OnBeforeURLRequest_Handler");
+  ctx->before_url_request_start_time = base::TimeTicks::Now();
   ctx->new_url = new_url;
   ctx->event_type = brave::kOnBeforeRequest;
+  ctx->before_url_request_stages = brave::SelectBeforeURLRequestStages(*ctx);
   callbacks_[ctx->request_identifier] = std::move(callback);
   RunNextCallback(ctx);
   return net::ERR_IO_PENDING;
@@ -192,13 +265,13 @@ void BraveRequestHandler::OnURLRequestDestroyed(
   if (base::Contains(callbacks_, ctx->request_identifier)) {
     callbacks_.erase(ctx->request_identifier);
   }
+  brave::OnURLRequestDestroyed_HttpseWork(ctx);
 }
 
 void BraveRequestHandler::RunCallbackForRequestIdentifier(
     uint64_t request_identifier,
     int rv) {
-  std::map<uint64_t, net::CompletionOnceCallback>::iterator it =
-      callbacks_.find(request_identifier);
+  auto it = callbacks_.find(request_identifier);
   // We intentionally do the async call to maintain the proper flow
   // of URLLoader callbacks.
   base::PostTask(FROM_HERE, {content::BrowserThread::UI},
@@ -221,13 +294,20 @@ void BraveRequestHandler::RunNextCallback(
   if (ctx->event_type == brave::kOnBeforeRequest) {
     while (before_url_request_callbacks_.size() !=
            ctx->next_url_request_index) {
-      brave::OnBeforeURLRequestCallback callback =
+      const BeforeURLRequestCallback& callback =
           before_url_request_callbacks_[ctx->next_url_request_index++];
+      if (!(ctx->before_url_request_stages & (1u << callback.stage)))
+        continue;
       brave::ResponseCallback next_callback = base::Bind(
           &BraveRequestHandler::RunNextCallback,
           weak_factory_.GetWeakPtr(),
           ctx);
-      rv = callback.Run(next_callback, ctx);
+      // Only the synchronous part of a stage is timed.
+      const base::TimeTicks start = base::TimeTicks::Now();
+      rv = callback.callback.Run(next_callback, ctx);
+      base::UmaHistogramTimes(
+          brave::kBeforeURLRequestStageHistograms[callback.stage],
+          base::TimeTicks::Now() - start);
       if (rv == net::ERR_IO_PENDING) {
         return;
       }
@@ -272,6 +352,14 @@ void BraveRequestHandler::RunNextCallback(
     }
   }
 
+  if (ctx->event_type == brave::kOnBeforeRequest) {
+    // Recorded once every stage is done, so stages that had to hop to
+    // another thread, such as ad-block cache misses, are included.
+    UMA_HISTOGRAM_TIMES(
+        "Brave.OnBeforeURLRequest_Handler",
+        base::TimeTicks::Now() - ctx->before_url_request_start_time);
+  }
+
   if (rv != net::OK) {
     RunCallbackForRequestIdentifier(ctx->request_identifier, rv);
     return;
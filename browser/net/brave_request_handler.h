@@ -6,9 +6,11 @@
 #ifndef BRAVE_BROWSER_NET_BRAVE_REQUEST_HANDLER_H_
 #define BRAVE_BROWSER_NET_BRAVE_REQUEST_HANDLER_H_
 
-#include <map>
+#include <stdint.h>
+
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "brave/browser/net/url_context.h"
@@ -17,6 +19,26 @@
 
 class PrefChangeRegistrar;
 
+namespace brave {
+
+// The OnBeforeURLRequest callbacks, in the order they run.
+enum BeforeURLRequestStage {
+  kSiteHacksStage,
+  kAdBlockTPStage,
+  kHttpseStage,
+  kCommonStaticRedirectStage,
+  kRewardsStage,
+  kTranslateRedirectStage,
+  kBeforeURLRequestStageCount,
+};
+
+// Returns a bitmask, indexed by BeforeURLRequestStage, of the stages that
+// might act on |ctx| judging by what is known before any of them runs. The
+// other stages are skipped without being called.
+uint32_t SelectBeforeURLRequestStages(const BraveRequestInfo& ctx);
+
+}  // namespace brave
+
 // Contains different network stack hooks (similar to capabilities of WebRequest
 // API).
 class BraveRequestHandler {
@@ -54,7 +76,15 @@ class BraveRequestHandler {
 
   void RunNextCallback(std::shared_ptr<brave::BraveRequestInfo> ctx);
 
-  std::vector<brave::OnBeforeURLRequestCallback> before_url_request_callbacks_;
+  struct BeforeURLRequestCallback {
+    brave::BeforeURLRequestStage stage;
+    brave::OnBeforeURLRequestCallback callback;
+  };
+
+  void AddBeforeURLRequestCallback(brave::BeforeURLRequestStage stage,
+                                   brave::OnBeforeURLRequestCallback callback);
+
+  std::vector<BeforeURLRequestCallback> before_url_request_callbacks_;
   std::vector<brave::OnBeforeStartTransactionCallback>
       before_start_transaction_callbacks_;
   std::vector<brave::OnHeadersReceivedCallback> headers_received_callbacks_;
@@ -65,7 +95,7 @@ class BraveRequestHandler {
   // PrefChangeRegistrar and corresponding |base::Unretained| usages, that are
   // illegal.
   std::unique_ptr<base::ListValue> referral_headers_list_;
-  std::map<uint64_t, net::CompletionOnceCallback> callbacks_;
+  std::unordered_map<uint64_t, net::CompletionOnceCallback> callbacks_;
   std::unique_ptr<PrefChangeRegistrar, content::BrowserThread::DeleteOnUIThread>
       pref_change_registrar_;
 
@@ -0,0 +1,69 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/brave_request_handler.h"
+
+#include "brave/browser/net/url_context.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace brave {
+
+namespace {
+
+bool HasStage(uint32_t stages, BeforeURLRequestStage stage) {
+  return stages & (1u << stage);
+}
+
+}  // namespace
+
+TEST(BraveRequestHandlerTest, SelectsNoShieldsStagesWithoutTab) {
+  BraveRequestInfo ctx(GURL("https://example.com/script.js"));
+  uint32_t stages = SelectBeforeURLRequestStages(ctx);
+  EXPECT_TRUE(HasStage(stages, kCommonStaticRedirectStage));
+  EXPECT_TRUE(HasStage(stages, kTranslateRedirectStage));
+  EXPECT_FALSE(HasStage(stages, kSiteHacksStage));
+  EXPECT_FALSE(HasStage(stages, kAdBlockTPStage));
+  EXPECT_FALSE(HasStage(stages, kHttpseStage));
+  EXPECT_FALSE(HasStage(stages, kRewardsStage));
+}
+
+TEST(BraveRequestHandlerTest, SelectsShieldsStagesForSubresource) {
+  BraveRequestInfo ctx(GURL("http://example.com/script.js?fbclid=1"));
+  ctx.tab_origin = GURL("https://brave.com/");
+  ctx.referrer = GURL("https://brave.com/index.html");
+  ctx.resource_type = blink::mojom::ResourceType::kScript;
+  ctx.upload_data = "data";
+  uint32_t stages = SelectBeforeURLRequestStages(ctx);
+  EXPECT_TRUE(HasStage(stages, kSiteHacksStage));
+  EXPECT_TRUE(HasStage(stages, kAdBlockTPStage));
+  EXPECT_TRUE(HasStage(stages, kHttpseStage));
+  EXPECT_TRUE(HasStage(stages, kRewardsStage));
+  EXPECT_FALSE(HasStage(stages, kTranslateRedirectStage));
+
+  ctx.allow_brave_shields = false;
+  stages = SelectBeforeURLRequestStages(ctx);
+  EXPECT_FALSE(HasStage(stages, kAdBlockTPStage));
+  EXPECT_FALSE(HasStage(stages, kHttpseStage));
+  // The query string filter doesn't depend on shields.
+  EXPECT_TRUE(HasStage(stages, kSiteHacksStage));
+}
+
+TEST(BraveRequestHandlerTest, SelectsSiteHacksForReferrers) {
+  BraveRequestInfo ctx(GURL("https://example.com/image.png"));
+  ctx.tab_origin = GURL("https://brave.com/");
+  ctx.referrer = GURL("https://brave.com/index.html");
+  ctx.resource_type = blink::mojom::ResourceType::kImage;
+  EXPECT_TRUE(HasStage(SelectBeforeURLRequestStages(ctx), kSiteHacksStage));
+
+  ctx.resource_type = blink::mojom::ResourceType::kSubFrame;
+  EXPECT_FALSE(HasStage(SelectBeforeURLRequestStages(ctx), kSiteHacksStage));
+
+  ctx.resource_type = blink::mojom::ResourceType::kImage;
+  ctx.allow_referrers = true;
+  EXPECT_FALSE(HasStage(SelectBeforeURLRequestStages(ctx), kSiteHacksStage));
+}
+
+}  // namespace brave
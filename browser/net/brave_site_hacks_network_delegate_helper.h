@@ -10,12 +10,21 @@
 
 #include "brave/browser/net/url_context.h"
 
+namespace brave_shields {
+class QueryStringFilterService;
+}
+
 namespace net {
 class URLRequest;
 }
 
 namespace brave {
 
+// Strips query string trackers with |service| instead of the browser
+// process one. Pass nullptr to undo.
+void SetQueryStringFilterServiceForTesting(
+    brave_shields::QueryStringFilterService* service);
+
 int OnBeforeURLRequest_SiteHacksWork(
     const ResponseCallback& next_callback,
     std::shared_ptr<BraveRequestInfo> ctx);
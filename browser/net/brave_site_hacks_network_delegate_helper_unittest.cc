@@ -12,11 +12,37 @@
 
 #include "brave/browser/net/url_context.h"
 #include "brave/common/network_constants.h"
+#include "brave/components/brave_component_updater/browser/local_data_files_service.h"
+#include "brave/components/brave_shields/browser/query_string_filter_service.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 using brave::ResponseCallback;
 
-TEST(BraveSiteHacksNetworkDelegateHelperTest, UAWhitelistedTest) {
+class BraveSiteHacksNetworkDelegateHelperTest : public testing::Test {
+ public:
+  void SetUp() override {
+    local_data_files_service_ =
+        std::make_unique<brave_component_updater::LocalDataFilesService>(
+            nullptr);
+    query_string_filter_service_ =
+        brave_shields::QueryStringFilterServiceFactory(
+            local_data_files_service_.get());
+    brave::SetQueryStringFilterServiceForTesting(
+        query_string_filter_service_.get());
+  }
+
+  void TearDown() override {
+    brave::SetQueryStringFilterServiceForTesting(nullptr);
+  }
+
+ private:
+  std::unique_ptr<brave_component_updater::LocalDataFilesService>
+      local_data_files_service_;
+  std::unique_ptr<brave_shields::QueryStringFilterService>
+      query_string_filter_service_;
+};
+
+TEST_F(BraveSiteHacksNetworkDelegateHelperTest, UAWhitelistedTest) {
   const std::vector<const GURL> urls(
       {GURL("https://duckduckgo.com"), GURL("https://duckduckgo.com/something"),
        GURL("https://netflix.com"), GURL("https://netflix.com/something"),
@@ -41,7 +67,7 @@ TEST(BraveSiteHacksNetworkDelegateHelperTest, UAWhitelistedTest) {
   }
 }
 
-TEST(BraveSiteHacksNetworkDelegateHelperTest, ChangeUAOnlyOnce) {
+TEST_F(BraveSiteHacksNetworkDelegateHelperTest, ChangeUAOnlyOnce) {
   const GURL whitelisted_url("https://netflix.com/");
   net::HttpRequestHeaders headers;
   headers.SetHeader(kUserAgentHeader,
@@ -70,7 +96,7 @@ TEST(BraveSiteHacksNetworkDelegateHelperTest, ChangeUAOnlyOnce) {
             "(KHTML, like Gecko) Brave Chrome/33.0.1750.117 Safari/537.36");
 }
 
-TEST(BraveSiteHacksNetworkDelegateHelperTest, NOTUAWhitelistedTest) {
+TEST_F(BraveSiteHacksNetworkDelegateHelperTest, NOTUAWhitelistedTest) {
   const std::vector<const GURL> urls({GURL("https://brianbondy.com"),
                                       GURL("https://bravecombo.com"),
                                       GURL("https://brave.example.com")});
@@ -91,7 +117,7 @@ TEST(BraveSiteHacksNetworkDelegateHelperTest, NOTUAWhitelistedTest) {
   }
 }
 
-TEST(BraveSiteHacksNetworkDelegateHelperTest, ReferrerPreserved) {
+TEST_F(BraveSiteHacksNetworkDelegateHelperTest, ReferrerPreserved) {
   const std::vector<const GURL> urls(
       {GURL("https://brianbondy.com/7"), GURL("https://www.brianbondy.com/5"),
        GURL("https://brian.bondy.brianbondy.com")});
@@ -110,7 +136,7 @@ TEST(BraveSiteHacksNetworkDelegateHelperTest, ReferrerPreserved) {
   }
 }
 
-TEST(BraveSiteHacksNetworkDelegateHelperTest, ReferrerTruncated) {
+TEST_F(BraveSiteHacksNetworkDelegateHelperTest, ReferrerTruncated) {
   const std::vector<const GURL> urls({GURL("https://digg.com/7"),
                                       GURL("https://slashdot.org/5"),
                                       GURL("https://bondy.brian.org")});
@@ -130,8 +156,8 @@ TEST(BraveSiteHacksNetworkDelegateHelperTest, ReferrerTruncated) {
   }
 }
 
-TEST(BraveSiteHacksNetworkDelegateHelperTest,
-     ReferrerWouldBeClearedButExtensionSite) {
+TEST_F(BraveSiteHacksNetworkDelegateHelperTest,
+       ReferrerWouldBeClearedButExtensionSite) {
   const std::vector<const GURL> urls({GURL("https://digg.com/7"),
                                       GURL("https://slashdot.org/5"),
                                       GURL("https://bondy.brian.org")});
@@ -151,7 +177,7 @@ TEST(BraveSiteHacksNetworkDelegateHelperTest,
   }
 }
 
-TEST(BraveSiteHacksNetworkDelegateHelperTest, QueryStringUntouched) {
+TEST_F(BraveSiteHacksNetworkDelegateHelperTest, QueryStringUntouched) {
   const std::vector<const std::string> urls({
       "https://example.com/",
       "https://example.com/?",
@@ -181,7 +207,7 @@ TEST(BraveSiteHacksNetworkDelegateHelperTest, QueryStringUntouched) {
   }
 }
 
-TEST(BraveSiteHacksNetworkDelegateHelperTest, QueryStringFiltered) {
+TEST_F(BraveSiteHacksNetworkDelegateHelperTest, QueryStringFiltered) {
   const std::vector<const std::pair<const std::string, const std::string>> urls(
       {
           // { original url, expected url after filtering }
@@ -0,0 +1,236 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/brave_static_redirect_rules.h"
+
+#include <limits>
+#include <utility>
+
+#include "base/no_destructor.h"
+#include "base/strings/string_piece.h"
+#include "brave/browser/translate/buildflags/buildflags.h"
+#include "brave/common/network_constants.h"
+#include "brave/common/translate_network_constants.h"
+#include "components/component_updater/component_updater_url_constants.h"
+#include "extensions/buildflags/buildflags.h"
+#include "url/gurl.h"
+
+#if BUILDFLAG(ENABLE_EXTENSIONS)
+#include "extensions/common/extension_urls.h"
+#endif
+
+namespace brave {
+
+namespace {
+
+enum RuleSet {
+  kCommonRuleSet,
+  kStaticRuleSet,
+};
+
+const int kHTTPAndHTTPS = URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS;
+
+void AddCommonRule(URLPatternHostIndex* index,
+                   CommonStaticRedirectRule rule,
+                   const URLPattern& pattern,
+                   URLPatternHostIndex::MatchType match_type =
+                       URLPatternHostIndex::MatchType::kURL) {
+  index->Add(kCommonRuleSet, static_cast<int>(rule), pattern, match_type);
+}
+
+void AddStaticRule(URLPatternHostIndex* index,
+                   StaticRedirectRule rule,
+                   const URLPattern& pattern,
+                   URLPatternHostIndex::MatchType match_type =
+                       URLPatternHostIndex::MatchType::kURL,
+                   const base::Optional<URLPattern>& exclusion =
+                       base::nullopt) {
+  index->Add(kStaticRuleSet, static_cast<int>(rule), pattern, match_type,
+             exclusion);
+}
+
+URLPatternHostIndex BuildStaticRedirectIndex() {
+  using MatchType = URLPatternHostIndex::MatchType;
+  URLPatternHostIndex index;
+
+  // Update server checks happen from the profile context for admin policy
+  // installed extensions. Update server checks happen from the system
+  // context for normal update operations.
+  AddCommonRule(
+      &index, CommonStaticRedirectRule::kUpdater,
+      URLPattern(URLPattern::SCHEME_HTTPS,
+                 std::string(component_updater::kUpdaterJSONDefaultUrl) + "*"));
+  AddCommonRule(
+      &index, CommonStaticRedirectRule::kUpdater,
+      URLPattern(
+          URLPattern::SCHEME_HTTP,
+          std::string(component_updater::kUpdaterJSONFallbackUrl) + "*"));
+#if BUILDFLAG(ENABLE_EXTENSIONS)
+  AddCommonRule(
+      &index, CommonStaticRedirectRule::kUpdater,
+      URLPattern(URLPattern::SCHEME_HTTPS,
+                 std::string(extension_urls::kChromeWebstoreUpdateURL) + "*"));
+#endif
+  AddCommonRule(&index, CommonStaticRedirectRule::kChromeCast,
+                URLPattern(kHTTPAndHTTPS, kChromeCastPrefix));
+  AddCommonRule(&index, CommonStaticRedirectRule::kClients4,
+                URLPattern(kHTTPAndHTTPS, kClients4Prefix), MatchType::kHost);
+  AddCommonRule(&index, CommonStaticRedirectRule::kBugsChromium,
+                URLPattern(kHTTPAndHTTPS,
+                           "*://bugs.chromium.org/p/chromium/issues/entry?*"));
+
+  AddStaticRule(&index, StaticRedirectRule::kGeolocation,
+                URLPattern(URLPattern::SCHEME_HTTPS, kGeoLocationsPattern));
+  AddStaticRule(&index, StaticRedirectRule::kSafeBrowsing,
+                URLPattern(URLPattern::SCHEME_HTTPS, kSafeBrowsingPrefix),
+                MatchType::kHost);
+  AddStaticRule(
+      &index, StaticRedirectRule::kSafeBrowsingFileCheck,
+      URLPattern(URLPattern::SCHEME_HTTPS, kSafeBrowsingFileCheckPrefix),
+      MatchType::kHost);
+  AddStaticRule(&index, StaticRedirectRule::kCRXDownload,
+                URLPattern(kHTTPAndHTTPS, kCRXDownloadPrefix));
+  AddStaticRule(&index, StaticRedirectRule::kAutofill,
+                URLPattern(URLPattern::SCHEME_HTTPS, kAutofillPrefix));
+  for (const char* crl_set_prefix :
+       {kCRLSetPrefix1, kCRLSetPrefix2, kCRLSetPrefix3, kCRLSetPrefix4}) {
+    AddStaticRule(&index, StaticRedirectRule::kCRLSet,
+                  URLPattern(kHTTPAndHTTPS, crl_set_prefix));
+  }
+  AddStaticRule(&index, StaticRedirectRule::kGvt1,
+                URLPattern(kHTTPAndHTTPS, "*://*.gvt1.com/*"), MatchType::kURL,
+                URLPattern(kHTTPAndHTTPS, kWidevineGvt1Prefix));
+  AddStaticRule(&index, StaticRedirectRule::kGoogleDl,
+                URLPattern(kHTTPAndHTTPS, "*://dl.google.com/*"),
+                MatchType::kURL,
+                URLPattern(kHTTPAndHTTPS, kWidevineGoogleDlPrefix));
+#if BUILDFLAG(ENABLE_BRAVE_TRANSLATE_GO)
+  AddStaticRule(
+      &index, StaticRedirectRule::kTranslate,
+      URLPattern(URLPattern::SCHEME_HTTPS, kTranslateElementJSPattern));
+  AddStaticRule(
+      &index, StaticRedirectRule::kTranslateLanguage,
+      URLPattern(URLPattern::SCHEME_HTTPS, kTranslateLanguagePattern));
+#endif
+  return index;
+}
+
+const URLPatternHostIndex& GetStaticRedirectIndex() {
+  static const base::NoDestructor<URLPatternHostIndex> index(
+      BuildStaticRedirectIndex());
+  return *index;
+}
+
+}  // namespace
+
+URLPatternHostIndex::Entry::Entry(int rule_set,
+                                  int rule,
+                                  const URLPattern& pattern,
+                                  MatchType match_type,
+                                  const base::Optional<URLPattern>& exclusion)
+    : rule_set(rule_set),
+      rule(rule),
+      pattern(pattern),
+      match_type(match_type),
+      exclusion(exclusion) {}
+
+URLPatternHostIndex::Entry::Entry(const Entry& other) = default;
+
+URLPatternHostIndex::Entry::~Entry() {}
+
+bool URLPatternHostIndex::Entry::Matches(const GURL& url) const {
+  bool matches = match_type == MatchType::kHost ? pattern.MatchesHost(url)
+                                                : pattern.MatchesURL(url);
+  return matches && !(exclusion && exclusion->MatchesURL(url));
+}
+
+URLPatternHostIndex::URLPatternHostIndex() {}
+
+URLPatternHostIndex::URLPatternHostIndex(URLPatternHostIndex&& other) =
+    default;
+
+URLPatternHostIndex::~URLPatternHostIndex() {}
+
+void URLPatternHostIndex::Add(int rule_set,
+                              int rule,
+                              const URLPattern& pattern,
+                              MatchType match_type,
+                              const base::Optional<URLPattern>& exclusion) {
+  const size_t index = entries_.size();
+  entries_.emplace_back(rule_set, rule, pattern, match_type, exclusion);
+  if (pattern.host().empty() && pattern.match_subdomains())
+    any_host_.push_back(index);
+  else if (pattern.match_subdomains())
+    domains_[pattern.host()].push_back(index);
+  else
+    hosts_[pattern.host()].push_back(index);
+}
+
+void URLPatternHostIndex::FindFirstMatchIn(
+    const std::vector<size_t>& candidates,
+    int rule_set,
+    const GURL& url,
+    size_t* first_match) const {
+  for (size_t index : candidates) {
+    if (index >= *first_match)
+      return;
+    if (entries_[index].rule_set == rule_set &&
+        entries_[index].Matches(url)) {
+      *first_match = index;
+      return;
+    }
+  }
+}
+
+base::Optional<int> URLPatternHostIndex::FindFirstMatch(
+    int rule_set,
+    const GURL& url) const {
+  base::StringPiece host = url.host_piece();
+  // URLPattern ignores a trailing dot in the host.
+  if (!host.empty() && host.back() == '.')
+    host.remove_suffix(1);
+
+  size_t first_match = std::numeric_limits<size_t>::max();
+  FindFirstMatchIn(any_host_, rule_set, url, &first_match);
+
+  auto it = hosts_.find(host);
+  if (it != hosts_.end())
+    FindFirstMatchIn(it->second, rule_set, url, &first_match);
+
+  // Try the host and each of its parent domains.
+  base::StringPiece domain = host;
+  while (!domain.empty()) {
+    it = domains_.find(domain);
+    if (it != domains_.end())
+      FindFirstMatchIn(it->second, rule_set, url, &first_match);
+    size_t dot = domain.find('.');
+    if (dot == base::StringPiece::npos)
+      break;
+    domain.remove_prefix(dot + 1);
+  }
+
+  if (first_match == std::numeric_limits<size_t>::max())
+    return base::nullopt;
+  return entries_[first_match].rule;
+}
+
+base::Optional<CommonStaticRedirectRule> MatchCommonStaticRedirectRule(
+    const GURL& url) {
+  base::Optional<int> rule =
+      GetStaticRedirectIndex().FindFirstMatch(kCommonRuleSet, url);
+  if (!rule)
+    return base::nullopt;
+  return static_cast<CommonStaticRedirectRule>(*rule);
+}
+
+base::Optional<StaticRedirectRule> MatchStaticRedirectRule(const GURL& url) {
+  base::Optional<int> rule =
+      GetStaticRedirectIndex().FindFirstMatch(kStaticRuleSet, url);
+  if (!rule)
+    return base::nullopt;
+  return static_cast<StaticRedirectRule>(*rule);
+}
+
+}  // namespace brave
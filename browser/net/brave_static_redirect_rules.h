@@ -0,0 +1,122 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_BROWSER_NET_BRAVE_STATIC_REDIRECT_RULES_H_
+#define BRAVE_BROWSER_NET_BRAVE_STATIC_REDIRECT_RULES_H_
+
+#include <stddef.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "base/containers/flat_map.h"
+#include "base/macros.h"
+#include "base/optional.h"
+#include "extensions/common/url_pattern.h"
+
+class GURL;
+
+namespace brave {
+
+// URLPatterns indexed by host. Matching a URL only tries the patterns for
+// its host and its parent domains, plus the patterns that match any host,
+// instead of every pattern in turn.
+class URLPatternHostIndex {
+ public:
+  enum class MatchType {
+    // URLPattern::MatchesURL()
+    kURL,
+    // URLPattern::MatchesHost(), which ignores the scheme and path.
+    kHost,
+  };
+
+  URLPatternHostIndex();
+  URLPatternHostIndex(URLPatternHostIndex&& other);
+  ~URLPatternHostIndex();
+
+  // Adds |pattern| for |rule| of |rule_set|. Rules are tried in the order
+  // they are added, and a rule may be added with several patterns. URLs
+  // that match |exclusion| aren't matched by this pattern.
+  void Add(int rule_set,
+           int rule,
+           const URLPattern& pattern,
+           MatchType match_type = MatchType::kURL,
+           const base::Optional<URLPattern>& exclusion = base::nullopt);
+
+  // Returns the first rule of |rule_set| that matches |url|.
+  base::Optional<int> FindFirstMatch(int rule_set, const GURL& url) const;
+
+ private:
+  struct Entry {
+    Entry(int rule_set,
+          int rule,
+          const URLPattern& pattern,
+          MatchType match_type,
+          const base::Optional<URLPattern>& exclusion);
+    Entry(const Entry& other);
+    ~Entry();
+
+    bool Matches(const GURL& url) const;
+
+    int rule_set;
+    int rule;
+    URLPattern pattern;
+    MatchType match_type;
+    base::Optional<URLPattern> exclusion;
+  };
+
+  // Entry indices in the order they were added, keyed by host.
+  using HostMap = base::flat_map<std::string, std::vector<size_t>, std::less<>>;
+
+  // Updates |first_match| if one of |candidates| with a lower index matches.
+  void FindFirstMatchIn(const std::vector<size_t>& candidates,
+                        int rule_set,
+                        const GURL& url,
+                        size_t* first_match) const;
+
+  std::vector<Entry> entries_;
+  // Patterns for exactly one host.
+  HostMap hosts_;
+  // Patterns for a domain and all of its subdomains, e.g. "*.gvt1.com".
+  HostMap domains_;
+  // Patterns for any host.
+  std::vector<size_t> any_host_;
+
+  DISALLOW_COPY_AND_ASSIGN(URLPatternHostIndex);
+};
+
+// The URLs rewritten by OnBeforeURLRequest_CommonStaticRedirectWorkForGURL,
+// in the order it checks them.
+enum class CommonStaticRedirectRule {
+  kUpdater,
+  kChromeCast,
+  kClients4,
+  kBugsChromium,
+};
+
+// The URLs rewritten by OnBeforeURLRequest_StaticRedirectWorkForGURL, in the
+// order it checks them.
+enum class StaticRedirectRule {
+  kGeolocation,
+  kSafeBrowsing,
+  kSafeBrowsingFileCheck,
+  kCRXDownload,
+  kAutofill,
+  kCRLSet,
+  kGvt1,
+  kGoogleDl,
+  kTranslate,
+  kTranslateLanguage,
+};
+
+// Both rule sets share a single index that is built on first use.
+base::Optional<CommonStaticRedirectRule> MatchCommonStaticRedirectRule(
+    const GURL& url);
+base::Optional<StaticRedirectRule> MatchStaticRedirectRule(const GURL& url);
+
+}  // namespace brave
+
+#endif  // BRAVE_BROWSER_NET_BRAVE_STATIC_REDIRECT_RULES_H_
@@ -0,0 +1,184 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/brave_static_redirect_rules.h"
+
+#include <string>
+
+#include "brave/browser/translate/buildflags/buildflags.h"
+#include "brave/common/network_constants.h"
+#include "brave/common/translate_network_constants.h"
+#include "components/component_updater/component_updater_url_constants.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace brave {
+
+namespace {
+
+const int kHTTPAndHTTPS = URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS;
+
+// The pattern chain OnBeforeURLRequest_StaticRedirectWorkForGURL walked
+// before the rules were indexed by host.
+base::Optional<StaticRedirectRule> MatchStaticRedirectRuleLinearly(
+    const GURL& url) {
+  static const URLPattern geo_pattern(URLPattern::SCHEME_HTTPS,
+                                      kGeoLocationsPattern);
+  static const URLPattern safebrowsing_pattern(URLPattern::SCHEME_HTTPS,
+                                               kSafeBrowsingPrefix);
+  static const URLPattern safebrowsing_file_check_pattern(
+      URLPattern::SCHEME_HTTPS, kSafeBrowsingFileCheckPrefix);
+  static const URLPattern crl_set_pattern1(kHTTPAndHTTPS, kCRLSetPrefix1);
+  static const URLPattern crl_set_pattern2(kHTTPAndHTTPS, kCRLSetPrefix2);
+  static const URLPattern crl_set_pattern3(kHTTPAndHTTPS, kCRLSetPrefix3);
+  static const URLPattern crl_set_pattern4(kHTTPAndHTTPS, kCRLSetPrefix4);
+  static const URLPattern crx_download_pattern(kHTTPAndHTTPS,
+                                               kCRXDownloadPrefix);
+  static const URLPattern autofill_pattern(URLPattern::SCHEME_HTTPS,
+                                           kAutofillPrefix);
+  static const URLPattern gvt1_pattern(kHTTPAndHTTPS, "*://*.gvt1.com/*");
+  static const URLPattern google_dl_pattern(kHTTPAndHTTPS,
+                                            "*://dl.google.com/*");
+  static const URLPattern widevine_gvt1_pattern(kHTTPAndHTTPS,
+                                                kWidevineGvt1Prefix);
+  static const URLPattern widevine_google_dl_pattern(kHTTPAndHTTPS,
+                                                     kWidevineGoogleDlPrefix);
+#if BUILDFLAG(ENABLE_BRAVE_TRANSLATE_GO)
+  static const URLPattern translate_pattern(URLPattern::SCHEME_HTTPS,
+                                            kTranslateElementJSPattern);
+  static const URLPattern translate_language_pattern(
+      URLPattern::SCHEME_HTTPS, kTranslateLanguagePattern);
+#endif
+
+  if (geo_pattern.MatchesURL(url))
+    return StaticRedirectRule::kGeolocation;
+  if (safebrowsing_pattern.MatchesHost(url))
+    return StaticRedirectRule::kSafeBrowsing;
+  if (safebrowsing_file_check_pattern.MatchesHost(url))
+    return StaticRedirectRule::kSafeBrowsingFileCheck;
+  if (crx_download_pattern.MatchesURL(url))
+    return StaticRedirectRule::kCRXDownload;
+  if (autofill_pattern.MatchesURL(url))
+    return StaticRedirectRule::kAutofill;
+  if (crl_set_pattern1.MatchesURL(url) || crl_set_pattern2.MatchesURL(url) ||
+      crl_set_pattern3.MatchesURL(url) || crl_set_pattern4.MatchesURL(url)) {
+    return StaticRedirectRule::kCRLSet;
+  }
+  if (gvt1_pattern.MatchesURL(url) && !widevine_gvt1_pattern.MatchesURL(url))
+    return StaticRedirectRule::kGvt1;
+  if (google_dl_pattern.MatchesURL(url) &&
+      !widevine_google_dl_pattern.MatchesURL(url)) {
+    return StaticRedirectRule::kGoogleDl;
+  }
+#if BUILDFLAG(ENABLE_BRAVE_TRANSLATE_GO)
+  if (translate_pattern.MatchesURL(url))
+    return StaticRedirectRule::kTranslate;
+  if (translate_language_pattern.MatchesURL(url))
+    return StaticRedirectRule::kTranslateLanguage;
+#endif
+  return base::nullopt;
+}
+
+// Ordinary page requests and browser service requests, including the
+// redirect exceptions.
+const char* const kRequestURLs[] = {
+    "https://www.example.com/",
+    "https://www.example.com/static/app.js",
+    "https://cdn.jsdelivr.net/npm/jquery@3.5.1/dist/jquery.min.js",
+    "https://fonts.gstatic.com/s/roboto/v20/KFOmCnqEu92Fr1Mu4mxK.woff2",
+    "https://www.google.com/search?q=brave",
+    "https://www.googleapis.com/youtube/v3/videos?id=1",
+    "https://i.ytimg.com/vi/abc/hqdefault.jpg",
+    "https://en.wikipedia.org/wiki/Main_Page",
+    "https://upload.wikimedia.org/wikipedia/commons/a/a9/Example.jpg",
+    "https://github.com/brave/brave-browser/issues",
+    "https://avatars.githubusercontent.com/u/12301619?s=60",
+    "https://news.ycombinator.com/item?id=1",
+    "http://localhost:8080/index.html",
+    "https://203.0.113.7/api",
+    "https://a.b.c.d.example.co.uk/deep/path?x=1",
+    "https://www.googleapis.com/geolocation/v1/geolocate?key=dummytoken",
+    "https://safebrowsing.googleapis.com/v4/threatListUpdates:fetch?$req=1",
+    "https://sb-ssl.google.com/safebrowsing/clientreport/download",
+    "https://clients2.googleusercontent.com/crx/blobs/QgAAAC6zw0qH2DJtnXe8Z7"
+    "rUJP1RM6lX7kVcwkQ56ujmG3AWgKyU/extension_1_0_0.crx",
+    "https://www.gstatic.com/autofill/weekly/bg.html",
+    "https://dl.google.com/release2/chrome_component/AJ4r388iQSJq_4819/"
+    "4819_all_crl-set-5934829738003798040.data.crx3",
+    "http://r2---sn-8xgp1vo-p5qe.gvt1.com/edgedl/release2/chrome_component/"
+    "AJ4r388iQSJq_4819/4819_all_crl-set-5934829738003798040.data.crx3",
+    "http://r1---sn-n4v7sn7y.gvt1.com/edgedl/chromewebstore/L2Nocm9tZV9leH"
+    "RlbnNpb24vYmxvYnMvYjYxQUFXaFBmeUFyVG5KQUxIZ2ZQLVlCUQ/1.0.0.0_"
+    "oimompecagnajdejgnnjijobebaeigek.crx",
+    "https://redirector.gvt1.com/edgedl/release2/update2/file.crx3",
+    "https://dl.google.com/chrome/mac/stable/GGRO/googlechrome.dmg",
+    "https://translate.googleapis.com/translate_a/element.js?cb=x",
+    "https://translate.googleapis.com/translate_a/l?client=chrome&hl=en",
+    "https://safebrowsing.googleapis.com.",
+};
+
+}  // namespace
+
+TEST(URLPatternHostIndexTest, MatchesInOrderAdded) {
+  URLPatternHostIndex index;
+  index.Add(0, 1, URLPattern(URLPattern::SCHEME_HTTPS, "https://*.a.com/x*"));
+  index.Add(0, 2, URLPattern(URLPattern::SCHEME_HTTPS, "https://b.a.com/*"));
+  index.Add(0, 3, URLPattern(URLPattern::SCHEME_HTTPS, "https://*/*.png"));
+  index.Add(1, 4, URLPattern(URLPattern::SCHEME_HTTPS, "https://b.a.com/*"));
+
+  EXPECT_EQ(1, index.FindFirstMatch(0, GURL("https://b.a.com/x.png")));
+  EXPECT_EQ(1, index.FindFirstMatch(0, GURL("https://a.com/x")));
+  EXPECT_EQ(2, index.FindFirstMatch(0, GURL("https://b.a.com/y.png")));
+  EXPECT_EQ(3, index.FindFirstMatch(0, GURL("https://c.a.com/y.png")));
+  EXPECT_EQ(4, index.FindFirstMatch(1, GURL("https://b.a.com/x")));
+  EXPECT_FALSE(index.FindFirstMatch(0, GURL("https://c.a.com/y")));
+  EXPECT_FALSE(index.FindFirstMatch(0, GURL("http://b.a.com/x")));
+  EXPECT_FALSE(index.FindFirstMatch(1, GURL("https://c.b.a.com/x")));
+  EXPECT_FALSE(index.FindFirstMatch(0, GURL("https://xa.com/x")));
+}
+
+TEST(URLPatternHostIndexTest, MatchTypeAndExclusion) {
+  URLPatternHostIndex index;
+  index.Add(0, 1, URLPattern(URLPattern::SCHEME_HTTPS, "https://a.com/"),
+            URLPatternHostIndex::MatchType::kHost);
+  index.Add(0, 2, URLPattern(kHTTPAndHTTPS, "*://*.b.com/*"),
+            URLPatternHostIndex::MatchType::kURL,
+            URLPattern(kHTTPAndHTTPS, "*://*.b.com/*skip*"));
+
+  EXPECT_EQ(1, index.FindFirstMatch(0, GURL("http://a.com/any/path")));
+  EXPECT_EQ(2, index.FindFirstMatch(0, GURL("http://c.b.com/keep")));
+  EXPECT_FALSE(index.FindFirstMatch(0, GURL("http://c.b.com/skip")));
+}
+
+TEST(BraveStaticRedirectRulesTest, CommonRules) {
+  EXPECT_EQ(CommonStaticRedirectRule::kUpdater,
+            MatchCommonStaticRedirectRule(GURL(
+                std::string(component_updater::kUpdaterJSONDefaultUrl) +
+                "?foo=bar")));
+  EXPECT_EQ(CommonStaticRedirectRule::kChromeCast,
+            MatchCommonStaticRedirectRule(GURL(
+                "https://r1---sn-n4v7sn7y.gvt1.com/edgedl/chromewebstore/"
+                "L2Nocm9tZV9leHRlbnNpb24vYmxvYnMvAAA/"
+                "7.5.0_pkedcjkdefgpdelpbcmbmeomcjbeemfm.crx")));
+  EXPECT_EQ(CommonStaticRedirectRule::kClients4,
+            MatchCommonStaticRedirectRule(
+                GURL("https://clients4.google.com/chrome-sync/dev")));
+  EXPECT_EQ(CommonStaticRedirectRule::kBugsChromium,
+            MatchCommonStaticRedirectRule(GURL(
+                "https://bugs.chromium.org/p/chromium/issues/entry?a=b")));
+  EXPECT_FALSE(MatchCommonStaticRedirectRule(GURL("https://www.gvt1.com/")));
+}
+
+// Checks the index against the pattern chain it replaced.
+TEST(BraveStaticRedirectRulesTest, MatchesLinearSearch) {
+  for (const char* spec : kRequestURLs) {
+    const GURL url(spec);
+    EXPECT_EQ(MatchStaticRedirectRuleLinearly(url),
+              MatchStaticRedirectRule(url))
+        << url;
+  }
+}
+
+}  // namespace brave
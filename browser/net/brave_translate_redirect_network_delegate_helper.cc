@@ -23,7 +23,7 @@ bool IsTranslateScriptRequest(const GURL& gurl) {
       URLPattern(URLPattern::SCHEME_HTTPS, kTranslateMainJSPattern),
       });
   return std::any_of(translate_patterns.begin(), translate_patterns.end(),
-      [&gurl](URLPattern pattern) {
+      [&gurl](const URLPattern& pattern) {
       return pattern.MatchesURL(gurl);
       });
 }
@@ -34,7 +34,7 @@ bool IsTranslateResourceRequest(const GURL& gurl) {
       URLPattern(URLPattern::SCHEME_HTTPS, kTranslateBrandingPNGPattern),
       });
   return std::any_of(translate_patterns.begin(), translate_patterns.end(),
-      [&gurl](URLPattern pattern) {
+      [&gurl](const URLPattern& pattern) {
       return pattern.MatchesURL(gurl);
       });
 }
@@ -10,6 +10,7 @@
 #include <set>
 #include <string>
 
+#include "base/time/time.h"
 #include "net/url_request/url_request.h"
 #include "third_party/blink/public/mojom/loader/resource_load_info.mojom-shared.h"
 #include "url/gurl.h"
@@ -76,6 +77,11 @@ struct BraveRequestInfo {
   int frame_tree_node_id = 0;
   uint64_t request_identifier = 0;
   size_t next_url_request_index = 0;
+  // The BeforeURLRequestStages that may act on this request.
+  uint32_t before_url_request_stages = 0;
+  // When OnBeforeURLRequest handling started, including any stages that
+  // finish asynchronously.
+  base::TimeTicks before_url_request_start_time;
 
   net::HttpRequestHeaders* headers = nullptr;
   // The following two sets are populated by |OnBeforeStartTransactionCallback|.
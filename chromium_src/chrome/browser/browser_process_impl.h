@@ -6,8 +6,8 @@
 #ifndef BRAVE_CHROMIUM_SRC_CHROME_BROWSER_BROWSER_PROCESS_IMPL_H_
 #define BRAVE_CHROMIUM_SRC_CHROME_BROWSER_BROWSER_PROCESS_IMPL_H_
 
-// Note: Init method name is quite common. To re-define only Init in
-// browser_process_impl.h, all other headers are added.
+// Note: Init method name is quite common. To re-define only Init and
+// StartTearDown in browser_process_impl.h, all other headers are added.
 #include "base/debug/stack_trace.h"
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
@@ -29,7 +29,9 @@
 #include "services/network/public/mojom/network_service.mojom-forward.h"
 
 #define Init virtual Init
+#define StartTearDown virtual StartTearDown
 #include "../../../../chrome/browser/browser_process_impl.h"
+#undef StartTearDown
 #undef Init
 
 #endif  // BRAVE_CHROMIUM_SRC_CHROME_BROWSER_BROWSER_PROCESS_IMPL_H_
@@ -3,9 +3,17 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <atomic>
+
 #define BRAVE_IS_RENDERER_CONTENT_SETTING \
   content_type == ContentSettingsType::AUTOPLAY ||
 
 #include "../../../../../../components/content_settings/core/common/content_settings.cc"
 
 #undef BRAVE_IS_RENDERER_CONTENT_SETTING
+
+// static
+uint64_t RendererContentSettingRules::NextBraveRulesGeneration() {
+  static std::atomic<uint64_t> generation(0);
+  return ++generation;
+}
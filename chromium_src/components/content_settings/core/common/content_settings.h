@@ -6,10 +6,16 @@
 #ifndef BRAVE_CHROMIUM_SRC_COMPONENTS_CONTENT_SETTINGS_CORE_COMMON_CONTENT_SETTINGS_H_
 #define BRAVE_CHROMIUM_SRC_COMPONENTS_CONTENT_SETTINGS_CORE_COMMON_CONTENT_SETTINGS_H_
 
-#define BRAVE_CONTENT_SETTINGS_H                  \
-  ContentSettingsForOneType autoplay_rules;       \
-  ContentSettingsForOneType fingerprinting_rules; \
-  ContentSettingsForOneType brave_shields_rules;
+// |brave_rules_generation| is never sent over IPC. Every rule set that is
+// constructed, including each one deserialized in a renderer, gets a new
+// value, while copies keep it. This lets renderers tell when the rules they
+// cached results for have been replaced.
+#define BRAVE_CONTENT_SETTINGS_H                                \
+  ContentSettingsForOneType autoplay_rules;                     \
+  ContentSettingsForOneType fingerprinting_rules;               \
+  ContentSettingsForOneType brave_shields_rules;                \
+  static uint64_t NextBraveRulesGeneration();                   \
+  uint64_t brave_rules_generation = NextBraveRulesGeneration();
 
 #include "../../../../../../components/content_settings/core/common/content_settings.h"
 
@@ -6,7 +6,9 @@
 #include "third_party/blink/renderer/core/dom/document.h"
 
 #include "base/strings/string_number_conversions.h"
+#include "brave/third_party/blink/renderer/brave_audio_farbler.h"
 #include "brave/third_party/blink/renderer/brave_farbling_constants.h"
+#include "brave/third_party/blink/renderer/brave_farbling_utils.h"
 #include "crypto/hmac.h"
 #include "third_party/blink/public/platform/web_content_settings_client.h"
 #include "third_party/blink/renderer/core/dom/document.h"
@@ -19,38 +21,7 @@
 #include "third_party/blink/renderer/platform/heap/handle.h"
 #include "third_party/blink/renderer/platform/network/network_utils.h"
 #include "third_party/blink/renderer/platform/supplementable.h"
-
-namespace {
-
-const uint64_t zero = 0;
-
-inline uint64_t lfsr_next(uint64_t v) {
-  return ((v >> 1) | (((v << 62) ^ (v << 61)) & (~(~zero << 63) << 62)));
-}
-
-float Identity(float value, size_t index) {
-  return value;
-}
-
-float ConstantMultiplier(double fudge_factor, float value, size_t index) {
-  return value * fudge_factor;
-}
-
-float PseudoRandomSequence(uint64_t seed, float value, size_t index) {
-  static uint64_t v;
-  const double maxUInt64AsDouble = UINT64_MAX;
-  if (index == 0) {
-    // start of loop, reset to initial seed which was passed in and is based on
-    // the domain key
-    v = seed;
-  }
-  // get next value in PRNG sequence
-  v = lfsr_next(v);
-  // return pseudo-random float between 0 and 0.1
-  return (v / maxUInt64AsDouble) / 10;
-}
-
-}  // namespace
+#include "third_party/skia/include/core/SkImage.h"
 
 namespace brave {
 
@@ -99,8 +70,7 @@ BraveSessionCache& BraveSessionCache::From(Document& document) {
   return *cache;
 }
 
-AudioFarblingCallback BraveSessionCache::GetAudioFarblingCallback(
-    blink::LocalFrame* frame) {
+AudioFarbler BraveSessionCache::GetAudioFarbler(blink::LocalFrame* frame) {
   if (farbling_enabled_ && frame && frame->GetContentSettingsClient()) {
     switch (frame->GetContentSettingsClient()->GetBraveFarblingLevel()) {
       case BraveFarblingLevel::OFF: {
@@ -112,15 +82,15 @@ AudioFarblingCallback BraveSessionCache::GetAudioFarblingCallback(
         double fudge_factor = 0.99 + ((*fudge / maxUInt64AsDouble) / 100);
         VLOG(1) << "audio fudge factor (based on session token) = "
                 << fudge_factor;
-        return base::BindRepeating(&ConstantMultiplier, fudge_factor);
+        return AudioFarbler::ConstantMultiplier(fudge_factor);
       }
       case BraveFarblingLevel::MAXIMUM: {
         uint64_t seed = *reinterpret_cast<uint64_t*>(domain_key_);
-        return base::BindRepeating(&PseudoRandomSequence, seed);
+        return AudioFarbler::PseudoRandomSequence(seed);
       }
     }
   }
-  return base::BindRepeating(&Identity);
+  return AudioFarbler();
 }
 
 scoped_refptr<blink::StaticBitmapImage> BraveSessionCache::PerturbPixels(
@@ -149,49 +119,44 @@ BraveSessionCache::PerturbPixelsInternal(
   DCHECK(image_bitmap);
   if (image_bitmap->IsNull())
     return image_bitmap;
+  // Canvas snapshots keep the same SkImage until the canvas is drawn to, so
+  // repeated reads of an unchanged canvas can reuse its canvas key instead of
+  // signing the pixels again.
+  sk_sp<SkImage> source_image =
+      image_bitmap->PaintImageForCurrentFrame().GetSkImage();
+  const uint32_t source_image_id = source_image ? source_image->uniqueID() : 0;
+
   // convert to an ImageDataBuffer to normalize the pixel data to RGBA, 4 bytes
   // per pixel
   std::unique_ptr<blink::ImageDataBuffer> data_buffer =
       blink::ImageDataBuffer::Create(image_bitmap);
   uint8_t* pixels = const_cast<uint8_t*>(data_buffer->Pixels());
-  // This needs to be type size_t because we pass it to base::StringPiece
-  // later for content hashing. This is safe because the maximum canvas
-  // dimensions are less than SIZE_T_MAX. (Width and height are each
-  // limited to 32,767 pixels.)
+  // This is safe because the maximum canvas dimensions are less than
+  // SIZE_T_MAX. (Width and height are each limited to 32,767 pixels.)
   const size_t pixel_count = data_buffer->Width() * data_buffer->Height();
   // choose which channel (R, G, or B) to perturb
   const uint8_t* first_byte = reinterpret_cast<const uint8_t*>(domain_key_);
   uint8_t channel = *first_byte % 3;
   // calculate initial seed to find first pixel to perturb, based on session
   // key, domain key, and canvas contents
-  crypto::HMAC h(crypto::HMAC::SHA256);
-  uint64_t session_plus_domain_key =
-      session_key_ ^ *reinterpret_cast<uint64_t*>(domain_key_);
-  CHECK(h.Init(reinterpret_cast<const unsigned char*>(&session_plus_domain_key),
-               sizeof session_plus_domain_key));
-  uint8_t canvas_key[32];
-  CHECK(h.Sign(
-      base::StringPiece(reinterpret_cast<const char*>(pixels), pixel_count),
-      canvas_key, sizeof canvas_key));
-  uint64_t v = *reinterpret_cast<uint64_t*>(canvas_key);
-  uint64_t pixel_index;
-  // iterate through 32-byte canvas key and use each bit to determine how to
-  // perturb the current pixel
-  for (int i = 0; i < 32; i++) {
-    uint8_t bit = canvas_key[i];
-    for (int j = 8; j >= 0; j--) {
-      pixel_index = 4 * (v % pixel_count) + channel;
-      pixels[pixel_index] = pixels[pixel_index] ^ (bit & 0x1);
-      bit = bit >> 1;
-      // find next pixel to perturb
-      v = lfsr_next(v);
-    }
+  uint8_t canvas_key[kCanvasKeySize];
+  if (!canvas_keys_.Get(source_image_id, canvas_key)) {
+    crypto::HMAC h(crypto::HMAC::SHA256);
+    uint64_t session_plus_domain_key =
+        session_key_ ^ *reinterpret_cast<uint64_t*>(domain_key_);
+    CHECK(h.Init(
+        reinterpret_cast<const unsigned char*>(&session_plus_domain_key),
+        sizeof session_plus_domain_key));
+    CHECK(h.Sign(base::StringPiece(reinterpret_cast<const char*>(pixels),
+                                   pixel_count),
+                 canvas_key, sizeof canvas_key));
+    canvas_keys_.Put(source_image_id, canvas_key);
   }
+  PerturbCanvasPixels(pixels, pixel_count, channel, canvas_key);
+
   // convert back to a StaticBitmapImage to return to the caller
-  scoped_refptr<blink::StaticBitmapImage> perturbed_bitmap =
-      blink::UnacceleratedStaticBitmapImage::Create(
-          data_buffer->RetainedImage());
-  return perturbed_bitmap;
+  return blink::UnacceleratedStaticBitmapImage::Create(
+      data_buffer->RetainedImage());
 }
 
 WTF::String BraveSessionCache::GenerateRandomString(std::string seed,
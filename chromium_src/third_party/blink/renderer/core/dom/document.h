@@ -10,7 +10,8 @@
 
 #include <random>
 
-#include "base/callback.h"
+#include "brave/third_party/blink/renderer/brave_audio_farbler.h"
+#include "brave/third_party/blink/renderer/brave_farbling_utils.h"
 
 using blink::Document;
 using blink::GarbageCollected;
@@ -27,8 +28,6 @@ class StaticBitmapImage;
 
 namespace brave {
 
-typedef base::RepeatingCallback<float(float, size_t)> AudioFarblingCallback;
-
 class CORE_EXPORT BraveSessionCache final
     : public GarbageCollected<BraveSessionCache>,
       public Supplement<Document> {
@@ -42,7 +41,7 @@ class CORE_EXPORT BraveSessionCache final
 
   static BraveSessionCache& From(Document&);
 
-  AudioFarblingCallback GetAudioFarblingCallback(blink::LocalFrame* frame);
+  AudioFarbler GetAudioFarbler(blink::LocalFrame* frame);
   scoped_refptr<blink::StaticBitmapImage> PerturbPixels(
       blink::LocalFrame* frame,
       scoped_refptr<blink::StaticBitmapImage> image_bitmap);
@@ -53,6 +52,9 @@ class CORE_EXPORT BraveSessionCache final
   bool farbling_enabled_;
   uint64_t session_key_;
   uint8_t domain_key_[32];
+  // The session and domain keys are fixed for the document, so the canvas key
+  // only depends on the source snapshot.
+  CanvasKeyCache canvas_keys_;
 
   scoped_refptr<blink::StaticBitmapImage> PerturbPixelsInternal(
       scoped_refptr<blink::StaticBitmapImage> image_bitmap);
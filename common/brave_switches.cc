@@ -54,4 +54,8 @@ const char kComponentUpdateIntervalInSec[] = "component-update-interval-in-sec";
 
 // Disables DOH using a runtime flag mainly for network audit
 const char kDisableDnsOverHttps[] = "disable-doh";
+
+// Overrides the number of entries in the HTTPS Everywhere recently used
+// rewrites cache.
+const char kHTTPSERecentlyUsedCacheSize[] = "httpse-recently-used-cache-size";
 }  // namespace switches
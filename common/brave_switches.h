@@ -38,6 +38,8 @@ extern const char kComponentUpdateIntervalInSec[];
 
 extern const char kDisableDnsOverHttps[];
 
+extern const char kHTTPSERecentlyUsedCacheSize[];
+
 }  // namespace switches
 
 #endif  // BRAVE_COMMON_BRAVE_SWITCHES_H_
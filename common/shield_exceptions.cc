@@ -20,7 +20,7 @@ bool IsUAWhitelisted(const GURL& gurl) {
     URLPattern(URLPattern::SCHEME_ALL, "https://*.netflix.com/*")
   });
   return std::any_of(whitelist_patterns.begin(), whitelist_patterns.end(),
-      [&gurl](URLPattern pattern){
+      [&gurl](const URLPattern& pattern){
         return pattern.MatchesURL(gurl);
       });
 }
@@ -11,6 +11,7 @@
 #include "base/bind.h"
 #include "base/command_line.h"
 #include "base/containers/flat_map.h"
+#include "base/feature_list.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/path_service.h"
@@ -37,6 +38,7 @@
 #include "brave/components/brave_ads/browser/ad_notification.h"
 #include "brave/components/brave_ads/browser/ads_notification_handler.h"
 #include "brave/components/brave_ads/browser/ads_p2a.h"
+#include "brave/components/brave_ads/common/features.h"
 #include "brave/components/brave_ads/common/pref_names.h"
 #include "brave/components/brave_ads/common/switches.h"
 #include "brave/components/brave_rewards/browser/rewards_notification_service.h"
@@ -209,6 +211,7 @@ AdsServiceImpl::AdsServiceImpl(Profile* profile) :
            base::TaskPriority::BEST_EFFORT,
             base::TaskShutdownBehavior::BLOCK_SHUTDOWN})),
     base_path_(profile_->GetPath().AppendASCII("ads_service")),
+    database_bridge_(nullptr, base::OnTaskRunnerDeleter(file_task_runner_)),
     last_idle_state_(ui::IdleState::IDLE_STATE_ACTIVE),
     display_service_(NotificationDisplayService::GetForProfile(profile_)),
     rewards_service_(brave_rewards::RewardsServiceFactory::GetForProfile(
@@ -222,7 +225,7 @@ AdsServiceImpl::AdsServiceImpl(Profile* profile) :
 }
 
 AdsServiceImpl::~AdsServiceImpl() {
-  file_task_runner_->DeleteSoon(FROM_HERE, database_.release());
+  ResetDatabase();
   g_brave_browser_process->user_model_file_service()->RemoveObserver(this);
 }
 
@@ -673,9 +676,7 @@ void AdsServiceImpl::ShutdownBatAds() {
 
   VLOG(1) << "Shutting down ads";
 
-  const bool success = file_task_runner_->DeleteSoon(FROM_HERE,
-      database_.release());
-  VLOG_IF(1, !success) << "Failed to release database";
+  ResetDatabase();
 
   bat_ads_->Shutdown(base::BindOnce(&AdsServiceImpl::OnShutdownBatAds,
       AsWeakPtr()));
@@ -780,9 +781,7 @@ void AdsServiceImpl::ResetAllState(
 
   VLOG(1) << "Shutting down and resetting ads state";
 
-  const bool success = file_task_runner_->DeleteSoon(FROM_HERE,
-      database_.release());
-  VLOG_IF(1, !success) << "Failed to release database";
+  ResetDatabase();
 
   bat_ads_->Shutdown(base::BindOnce(&AdsServiceImpl::OnShutdownAndResetBatAds,
       AsWeakPtr()));
@@ -831,14 +830,16 @@ void AdsServiceImpl::OnEnsureBaseDirectoryExists(
 
   BackgroundHelper::GetInstance()->AddObserver(this);
 
+  ResetDatabase();
+  database_ = std::make_unique<ads::Database>(
+      base_path_.AppendASCII("database.sqlite"));
+
   bat_ads_service_->Create(
       bat_ads_client_receiver_.BindNewEndpointAndPassRemote(),
       bat_ads_.BindNewEndpointAndPassReceiver(),
+      MaybeBindDatabase(),
       base::BindOnce(&AdsServiceImpl::OnCreate, AsWeakPtr()));
 
-  database_ = std::make_unique<ads::Database>(
-      base_path_.AppendASCII("database.sqlite"));
-
   OnWalletUpdated();
 
   const std::string locale = GetLocale();
@@ -847,6 +848,41 @@ void AdsServiceImpl::OnEnsureBaseDirectoryExists(
   MaybeShowMyFirstAdNotification();
 }
 
+mojo::PendingRemote<bat_ads::mojom::BatAdsDatabase>
+AdsServiceImpl::MaybeBindDatabase() {
+  DCHECK(database_);
+
+  if (!base::FeatureList::IsEnabled(features::kDirectDatabaseAccess)) {
+    return mojo::NullRemote();
+  }
+
+  mojo::PendingRemote<bat_ads::mojom::BatAdsDatabase> bat_ads_database;
+
+  // |database_bridge_| is deleted on |file_task_runner_|, so it outlives the
+  // bind task
+  database_bridge_.reset(new bat_ads::AdsDatabaseMojoBridge(database_.get()));
+  file_task_runner_->PostTask(FROM_HERE,
+      base::BindOnce(&bat_ads::AdsDatabaseMojoBridge::Bind,
+          base::Unretained(database_bridge_.get()),
+          bat_ads_database.InitWithNewPipeAndPassReceiver()));
+
+  return bat_ads_database;
+}
+
+void AdsServiceImpl::ResetDatabase() {
+  // |database_bridge_| must be deleted before |database_|, as it runs
+  // transactions against |database_| on |file_task_runner_|
+  database_bridge_.reset();
+
+  if (!database_) {
+    return;
+  }
+
+  const bool success = file_task_runner_->DeleteSoon(FROM_HERE,
+      database_.release());
+  VLOG_IF(1, !success) << "Failed to release database";
+}
+
 void AdsServiceImpl::SetEnvironment() {
   ads::Environment environment;
 
@@ -17,6 +17,7 @@
 #include "base/containers/flat_set.h"
 #include "base/files/file_path.h"
 #include "base/memory/weak_ptr.h"
+#include "base/sequenced_task_runner.h"
 #include "base/timer/timer.h"
 #include "bat/ads/ads.h"
 #include "bat/ads/ads_client.h"
@@ -26,6 +27,7 @@
 #include "brave/components/brave_ads/browser/background_helper.h"
 #include "brave/components/brave_ads/browser/notification_helper.h"
 #include "brave/components/brave_user_model/browser/user_model_file_service.h"
+#include "brave/components/services/bat_ads/public/cpp/ads_database_mojo_bridge.h"
 #include "brave/components/services/bat_ads/public/interfaces/bat_ads.mojom.h"
 #include "brave/components/brave_rewards/browser/rewards_notification_service_observer.h"
 #include "chrome/browser/notifications/notification_handler.h"
@@ -33,6 +35,7 @@
 #include "components/prefs/pref_change_registrar.h"
 #include "mojo/public/cpp/bindings/associated_receiver.h"
 #include "mojo/public/cpp/bindings/associated_remote.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
 #include "mojo/public/cpp/bindings/remote.h"
 #include "services/network/public/mojom/url_response_head.mojom.h"
 #include "ui/base/idle/idle.h"
@@ -215,6 +218,9 @@ class AdsServiceImpl : public AdsService,
   void OnEnsureBaseDirectoryExists(
       const bool success);
 
+  mojo::PendingRemote<bat_ads::mojom::BatAdsDatabase> MaybeBindDatabase();
+  void ResetDatabase();
+
   void SetEnvironment();
 
   void SetBuildChannel();
@@ -473,6 +479,11 @@ class AdsServiceImpl : public AdsService,
 
   std::unique_ptr<ads::Database> database_;
 
+  // Runs database transactions on |file_task_runner_| if direct database
+  // access is enabled
+  std::unique_ptr<bat_ads::AdsDatabaseMojoBridge, base::OnTaskRunnerDeleter>
+      database_bridge_;
+
   ui::IdleState last_idle_state_;
 
   base::RepeatingTimer idle_poll_timer_;
@@ -6,8 +6,10 @@
 #include "brave/components/brave_ads/browser/ads_tab_helper.h"
 
 #include <memory>
+#include <string>
 #include <utility>
 
+#include "base/strings/stringprintf.h"
 #include "brave/components/brave_ads/browser/ads_service.h"
 #include "brave/components/brave_ads/browser/ads_service_factory.h"
 #include "chrome/browser/profiles/profile.h"
@@ -27,6 +29,54 @@
 
 namespace brave_ads {
 
+namespace {
+
+// Maximum number of characters of page text sent to the ads service for
+// classification
+const int kMaxPageTextLength = 64 * 1024;
+
+// Number of evenly spaced samples taken from page text which is longer than
+// |kMaxPageTextLength|
+const int kPageTextSampleCount = 4;
+
+// Returns the text of the page, or evenly spaced samples trimmed to whole
+// words if the text is too long, so that large pages are not copied to the
+// browser process in full
+std::string GetExtractPageTextScript() {
+  return base::StringPrintf(R"(
+      (function() {
+        if (!document.body) {
+          return '';
+        }
+
+        const text = document.body.innerText;
+        if (text.length <= %d) {
+          return text;
+        }
+
+        const sampleLength = Math.floor(%d / %d);
+        const step = (text.length - sampleLength) / (%d - 1);
+
+        const samples = [];
+        for (let i = 0; i < %d; i++) {
+          const start = Math.floor(i * step);
+          let sample = text.substr(start, sampleLength);
+          if (start > 0) {
+            sample = sample.replace(/^\S*\s/, '');
+          }
+          if (start + sampleLength < text.length) {
+            sample = sample.replace(/\s\S*$/, '');
+          }
+          samples.push(sample);
+        }
+
+        return samples.join('\n');
+      })())", kMaxPageTextLength, kMaxPageTextLength, kPageTextSampleCount,
+          kPageTextSampleCount, kPageTextSampleCount);
+}
+
+}  // namespace
+
 AdsTabHelper::AdsTabHelper(content::WebContents* web_contents)
     : WebContentsObserver(web_contents),
       tab_id_(sessions::SessionTabHelper::IdForTab(web_contents)),
@@ -78,7 +128,7 @@ void AdsTabHelper::RunIsolatedJavaScript(
   DCHECK(render_frame_host);
 
   dom_distiller::RunIsolatedJavaScript(render_frame_host,
-      "document.body.innerText",
+      GetExtractPageTextScript(),
           base::BindOnce(&AdsTabHelper::OnJavaScriptResult,
               weak_factory_.GetWeakPtr()));
 }
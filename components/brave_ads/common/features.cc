@@ -0,0 +1,18 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_ads/common/features.h"
+
+#include "base/feature_list.h"
+
+namespace brave_ads {
+namespace features {
+
+const base::Feature kDirectDatabaseAccess{
+    "BraveAdsDirectDatabaseAccess",
+    base::FEATURE_DISABLED_BY_DEFAULT};
+
+}  // namespace features
+}  // namespace brave_ads
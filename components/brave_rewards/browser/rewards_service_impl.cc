@@ -16,6 +16,7 @@
 #include "base/bind.h"
 #include "base/command_line.h"
 #include "base/containers/flat_map.h"
+#include "base/feature_list.h"
 #include "base/files/file_util.h"
 #include "base/files/important_file_writer.h"
 #include "base/i18n/time_formatting.h"
@@ -60,6 +61,7 @@
 #include "brave/components/brave_rewards/browser/rewards_service_observer.h"
 #include "brave/components/brave_rewards/browser/static_values.h"
 #include "brave/components/brave_rewards/browser/switches.h"
+#include "brave/components/brave_rewards/common/features.h"
 #include "brave/components/brave_rewards/common/pref_names.h"
 #include "brave/components/services/bat_ledger/public/cpp/ledger_client_mojo_bridge.h"
 #include "chrome/browser/bitmap_fetcher/bitmap_fetcher_service_factory.h"
@@ -336,6 +338,8 @@ RewardsServiceImpl::RewardsServiceImpl(Profile* profile)
       publisher_state_path_(profile_->GetPath().Append(kPublisher_state)),
       publisher_info_db_path_(profile->GetPath().Append(kPublisher_info_db)),
       publisher_list_path_(profile->GetPath().Append(kPublishers_list)),
+      ledger_database_bridge_(nullptr,
+          base::OnTaskRunnerDeleter(file_task_runner_)),
       notification_service_(new RewardsNotificationServiceImpl(profile)),
       next_timer_id_(0) {
   // Set up the rewards data source
@@ -345,9 +349,7 @@ RewardsServiceImpl::RewardsServiceImpl(Profile* profile)
 }
 
 RewardsServiceImpl::~RewardsServiceImpl() {
-  if (ledger_database_) {
-    file_task_runner_->DeleteSoon(FROM_HERE, ledger_database_.release());
-  }
+  ResetLedgerDatabase();
   StopNotificationTimers();
 }
 
@@ -394,6 +396,7 @@ void RewardsServiceImpl::StartLedger() {
     return;
   }
 
+  ResetLedgerDatabase();
   ledger_database_.reset(
       ledger::LedgerDatabase::CreateInstance(publisher_info_db_path_));
 
@@ -439,9 +442,47 @@ void RewardsServiceImpl::StartLedger() {
   bat_ledger_service_->Create(
       bat_ledger_client_receiver_.BindNewEndpointAndPassRemote(),
       bat_ledger_.BindNewEndpointAndPassReceiver(),
+      MaybeBindLedgerDatabase(),
       base::BindOnce(&RewardsServiceImpl::OnCreate, AsWeakPtr()));
 }
 
+mojo::PendingRemote<bat_ledger::mojom::BatLedgerDatabase>
+RewardsServiceImpl::MaybeBindLedgerDatabase() {
+  DCHECK(ledger_database_);
+
+  if (!base::FeatureList::IsEnabled(features::kDirectDatabaseAccess)) {
+    return mojo::NullRemote();
+  }
+
+  mojo::PendingRemote<bat_ledger::mojom::BatLedgerDatabase> database;
+
+  // |ledger_database_bridge_| is deleted on |file_task_runner_|, so it
+  // outlives the bind task
+  ledger_database_bridge_.reset(
+      new bat_ledger::LedgerDatabaseMojoBridge(ledger_database_.get()));
+  file_task_runner_->PostTask(
+      FROM_HERE,
+      base::BindOnce(&bat_ledger::LedgerDatabaseMojoBridge::Bind,
+          base::Unretained(ledger_database_bridge_.get()),
+          database.InitWithNewPipeAndPassReceiver()));
+
+  return database;
+}
+
+void RewardsServiceImpl::ResetLedgerDatabase() {
+  // |ledger_database_bridge_| must be deleted before |ledger_database_|, as it
+  // runs transactions against |ledger_database_| on |file_task_runner_|
+  ledger_database_bridge_.reset();
+
+  if (!ledger_database_) {
+    return;
+  }
+
+  const bool success =
+      file_task_runner_->DeleteSoon(FROM_HERE, ledger_database_.release());
+  BLOG_IF(1, !success, "Database was not released");
+}
+
 void RewardsServiceImpl::OnCreate() {
   if (!Connected()) {
     return;
@@ -1551,9 +1592,7 @@ void RewardsServiceImpl::Reset() {
   bat_ledger_service_.reset();
   is_wallet_initialized_ = false;
   ready_ = std::make_unique<base::OneShotEvent>();
-  bool success =
-      file_task_runner_->DeleteSoon(FROM_HERE, ledger_database_.release());
-  BLOG_IF(1, !success, "Database was not released");
+  ResetLedgerDatabase();
   BLOG(1, "Successfully reset rewards service");
 }
 
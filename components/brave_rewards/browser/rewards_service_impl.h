@@ -20,8 +20,10 @@
 #include "base/observer_list.h"
 #include "base/one_shot_event.h"
 #include "base/memory/weak_ptr.h"
+#include "base/sequenced_task_runner.h"
 #include "base/values.h"
 #include "bat/ledger/ledger_client.h"
+#include "brave/components/services/bat_ledger/public/cpp/ledger_database_mojo_bridge.h"
 #include "brave/components/services/bat_ledger/public/interfaces/bat_ledger.mojom.h"
 #include "brave/components/brave_rewards/browser/rewards_service.h"
 #include "brave/components/greaselion/browser/buildflags/buildflags.h"
@@ -29,6 +31,7 @@
 #include "content/public/browser/browser_thread.h"
 #include "mojo/public/cpp/bindings/associated_receiver.h"
 #include "mojo/public/cpp/bindings/associated_remote.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
 #include "mojo/public/cpp/bindings/remote.h"
 #include "brave/components/brave_rewards/browser/balance_report.h"
 #include "brave/components/brave_rewards/browser/content_site.h"
@@ -353,6 +356,10 @@ class RewardsServiceImpl : public RewardsService,
 
   void OnCreate();
 
+  mojo::PendingRemote<bat_ledger::mojom::BatLedgerDatabase>
+  MaybeBindLedgerDatabase();
+  void ResetLedgerDatabase();
+
   void OnResult(ledger::ResultCallback callback, const ledger::Result result);
 
   void OnCreateWallet(CreateWalletCallback callback,
@@ -744,6 +751,10 @@ class RewardsServiceImpl : public RewardsService,
   const base::FilePath publisher_info_db_path_;
   const base::FilePath publisher_list_path_;
   std::unique_ptr<ledger::LedgerDatabase> ledger_database_;
+  // Runs database transactions on |file_task_runner_| if direct database
+  // access is enabled
+  std::unique_ptr<bat_ledger::LedgerDatabaseMojoBridge,
+                  base::OnTaskRunnerDeleter> ledger_database_bridge_;
   std::unique_ptr<RewardsNotificationServiceImpl> notification_service_;
   base::ObserverList<RewardsServicePrivateObserver> private_observers_;
   std::unique_ptr<RewardsServiceObserver> extension_observer_;
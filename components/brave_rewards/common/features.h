@@ -0,0 +1,23 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_REWARDS_COMMON_FEATURES_H_
+#define BRAVE_COMPONENTS_BRAVE_REWARDS_COMMON_FEATURES_H_
+
+namespace base {
+struct Feature;
+}  // namespace base
+
+namespace brave_rewards {
+namespace features {
+
+// Runs bat ledger database transactions directly on the browser database
+// sequence instead of through the browser UI thread
+extern const base::Feature kDirectDatabaseAccess;
+
+}  // namespace features
+}  // namespace brave_rewards
+
+#endif  // BRAVE_COMPONENTS_BRAVE_REWARDS_COMMON_FEATURES_H_
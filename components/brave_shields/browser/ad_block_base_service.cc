@@ -12,7 +12,6 @@
 
 #include "base/bind.h"
 #include "base/files/file_path.h"
-#include "base/json/json_reader.h"
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
 #include "base/strings/utf_string_conversions.h"
@@ -20,84 +19,32 @@
 #include "brave/browser/net/url_context.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/brave_component_updater/browser/dat_file_util.h"
+#include "brave/components/brave_shields/browser/ad_block_request_matcher.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "brave/vendor/adblock_rust_ffi/src/wrapper.hpp"
 #include "components/prefs/pref_service.h"
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
-#include "net/base/registry_controlled_domains/registry_controlled_domain.h"
-#include "url/origin.h"
 
 using brave_component_updater::BraveComponent;
 using content::BrowserThread;
-using namespace net::registry_controlled_domains;  // NOLINT
 
 namespace {
 
-std::string ResourceTypeToString(blink::mojom::ResourceType resource_type) {
-  std::string filter_option = "";
-  switch (resource_type) {
-    // top level page
-    case blink::mojom::ResourceType::kMainFrame:
-      filter_option = "main_frame";
-      break;
-    // frame or iframe
-    case blink::mojom::ResourceType::kSubFrame:
-      filter_option = "sub_frame";
-      break;
-    // a CSS stylesheet
-    case blink::mojom::ResourceType::kStylesheet:
-      filter_option = "stylesheet";
-      break;
-    // an external script
-    case blink::mojom::ResourceType::kScript:
-      filter_option = "script";
-      break;
-    // an image (jpg/gif/png/etc)
-    case blink::mojom::ResourceType::kFavicon:
-    case blink::mojom::ResourceType::kImage:
-      filter_option = "image";
-      break;
-    // a font
-    case blink::mojom::ResourceType::kFontResource:
-      filter_option = "font";
-      break;
-    // an "other" subresource.
-    case blink::mojom::ResourceType::kSubResource:
-      filter_option = "other";
-      break;
-    // an object (or embed) tag for a plugin.
-    case blink::mojom::ResourceType::kObject:
-      filter_option = "object";
-      break;
-    // a media resource.
-    case blink::mojom::ResourceType::kMedia:
-      filter_option = "media";
-      break;
-    // a XMLHttpRequest
-    case blink::mojom::ResourceType::kXhr:
-      filter_option = "xhr";
-      break;
-    // a ping request for <a ping>/sendBeacon.
-    case blink::mojom::ResourceType::kPing:
-      filter_option = "ping";
-      break;
-    // the main resource of a dedicated worker.
-    case blink::mojom::ResourceType::kWorker:
-    // the main resource of a shared worker.
-    case blink::mojom::ResourceType::kSharedWorker:
-    // an explicitly requested prefetch
-    case blink::mojom::ResourceType::kPrefetch:
-    // the main resource of a service worker.
-    case blink::mojom::ResourceType::kServiceWorker:
-    // a report of Content Security Policy violations.
-    case blink::mojom::ResourceType::kCspReport:
-    // a resource that a plugin requested.
-    case blink::mojom::ResourceType::kPluginResource:
-    default:
-      break;
+// Folds the decision of a single engine into the result accumulated over
+// all engines consulted so far. Returns true if no further engine needs to
+// be consulted.
+bool MergeEngineResult(brave_shields::AdBlockMatchResult engine_result,
+                       brave_shields::AdBlockMatchResult* result) {
+  result->did_match_rule = engine_result.did_match_rule;
+  result->did_match_exception = engine_result.did_match_exception;
+  if (engine_result.did_match_rule) {
+    result->cancel_request_explicitly = engine_result.cancel_request_explicitly;
   }
-  return filter_option;
+  if (!engine_result.mock_data_url.empty()) {
+    result->mock_data_url = std::move(engine_result.mock_data_url);
+  }
+  return engine_result.did_match_rule || engine_result.did_match_exception;
 }
 
 }  // namespace
@@ -122,40 +69,52 @@ bool AdBlockBaseService::ShouldStartRequest(
     std::string* mock_data_url) {
   DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
 
-  // Determine third-party here so the library doesn't need to figure it out.
-  // CreateFromNormalizedTuple is needed because SameDomainOrHost needs
-  // a URL or origin and not a string to a host name.
-  bool is_third_party = !SameDomainOrHost(
-      url,
-      url::Origin::CreateFromNormalizedTuple("https", tab_host.c_str(), 80),
-      INCLUDE_PRIVATE_REGISTRIES);
-  bool explicit_cancel;
-  bool saved_from_exception;
-  if (ad_block_client_->matches(
-          url.spec(), url.host(), tab_host, is_third_party,
-          ResourceTypeToString(resource_type), &explicit_cancel,
-          &saved_from_exception, mock_data_url)) {
+  AdBlockMatchResult result;
+  MatchRequest(AdBlockRequest(url, resource_type, tab_host), &result);
+  if (result.did_match_rule) {
     if (cancel_request_explicitly) {
-      *cancel_request_explicitly = explicit_cancel;
+      *cancel_request_explicitly = result.cancel_request_explicitly;
     }
     // We'd only possibly match an exception filter if we're returning true.
     if (did_match_exception) {
       *did_match_exception = false;
     }
-    // LOG(ERROR) << "AdBlockBaseService::ShouldStartRequest(), host: "
-    //  << tab_host
-    //  << ", resource type: " << resource_type
-    //  << ", url.spec(): " << url.spec();
+    if (mock_data_url) {
+      *mock_data_url = std::move(result.mock_data_url);
+    }
     return false;
   }
 
   if (did_match_exception) {
-    *did_match_exception = saved_from_exception;
+    *did_match_exception = result.did_match_exception;
   }
 
   return true;
 }
 
+bool AdBlockBaseService::MatchRequest(const AdBlockRequest& request,
+                                      AdBlockMatchResult* result) {
+  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+  AdBlockMatchResult engine_result;
+  uint64_t generation;
+  if (!decision_cache_.Get(request, &engine_result, &generation)) {
+    MatchAdBlockRequest(ad_block_client_.get(), request, &engine_result);
+    decision_cache_.Put(request, engine_result, generation);
+  }
+  return MergeEngineResult(std::move(engine_result), result);
+}
+
+bool AdBlockBaseService::MatchRequestFromCache(const AdBlockRequest& request,
+                                               AdBlockMatchResult* result,
+                                               bool* matched) {
+  AdBlockMatchResult engine_result;
+  if (!decision_cache_.Peek(request, &engine_result)) {
+    return false;
+  }
+  *matched = MergeEngineResult(std::move(engine_result), result);
+  return true;
+}
+
 void AdBlockBaseService::EnableTag(const std::string& tag, bool enabled) {
   if (BrowserThread::CurrentlyOn(BrowserThread::UI)) {
     GetTaskRunner()->PostTask(
@@ -164,6 +123,7 @@ void AdBlockBaseService::EnableTag(const std::string& tag, bool enabled) {
     return;
   }
 
+  decision_cache_.Invalidate();
   if (enabled) {
     ad_block_client_->addTag(tag);
     tags_.push_back(tag);
@@ -185,6 +145,7 @@ void AdBlockBaseService::AddResources(const std::string& resources) {
     return;
   }
 
+  decision_cache_.Invalidate();
   ad_block_client_->addResources(resources);
   resources_ = resources;
 }
@@ -193,18 +154,20 @@ bool AdBlockBaseService::TagExists(const std::string& tag) {
   return std::find(tags_.begin(), tags_.end(), tag) != tags_.end();
 }
 
-base::Optional<base::Value> AdBlockBaseService::UrlCosmeticResources(
+base::Optional<CosmeticResources> AdBlockBaseService::UrlCosmeticResources(
         const std::string& url) {
   DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
-  return base::JSONReader::Read(ad_block_client_->urlCosmeticResources(url));
+  return CosmeticResources::FromJSON(
+      ad_block_client_->urlCosmeticResources(url));
 }
 
-base::Optional<base::Value> AdBlockBaseService::HiddenClassIdSelectors(
+base::Optional<std::vector<std::string>>
+AdBlockBaseService::HiddenClassIdSelectors(
         const std::vector<std::string>& classes,
         const std::vector<std::string>& ids,
         const std::vector<std::string>& exceptions) {
   DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
-  return base::JSONReader::Read(
+  return HiddenSelectorsFromJSON(
       ad_block_client_->hiddenClassIdSelectors(classes, ids, exceptions));
 }
 
@@ -235,6 +198,7 @@ void AdBlockBaseService::OnGetDATFileData(GetDATFileDataResult result) {
 void AdBlockBaseService::UpdateAdBlockClient(
     std::unique_ptr<adblock::Engine> ad_block_client) {
   DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+  decision_cache_.Invalidate();
   ad_block_client_ = std::move(ad_block_client);
   AddKnownTagsToAdBlockInstance();
   AddKnownResourcesToAdBlockInstance();
@@ -258,6 +222,7 @@ void AdBlockBaseService::ResetForTest(const std::string& rules,
   // This is temporary until adblock-rust supports incrementally adding
   // filter rules to an existing instance. At which point the hack below
   // will dissapear.
+  decision_cache_.Invalidate();
   ad_block_client_.reset(new adblock::Engine(rules));
   AddKnownTagsToAdBlockInstance();
   if (!resources.empty()) {
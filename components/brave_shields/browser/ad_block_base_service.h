@@ -17,6 +17,8 @@
 #include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
 #include "base/values.h"
+#include "brave/components/brave_shields/browser/ad_block_cosmetic_resources.h"
+#include "brave/components/brave_shields/browser/ad_block_decision_cache.h"
 #include "brave/components/brave_shields/browser/base_brave_shields_service.h"
 #include "brave/components/brave_component_updater/browser/dat_file_util.h"
 #include "third_party/blink/public/mojom/loader/resource_load_info.mojom-shared.h"
@@ -46,13 +48,24 @@ class AdBlockBaseService : public BaseBraveShieldsService {
                           bool* did_match_exception,
                           bool* cancel_request_explicitly,
                           std::string* mock_data_url) override;
+  // Runs a request that has already been tokenized through this service's
+  // engine. Returns true if the request matched a blocking or an exception
+  // rule, in which case no lower-priority engine needs to be consulted.
+  bool MatchRequest(const AdBlockRequest& request, AdBlockMatchResult* result);
+  // Same as MatchRequest, but only answers from decisions this engine has
+  // already made, so it can be called from any thread. Returns false if the
+  // decision isn't cached; otherwise sets |matched| to what MatchRequest
+  // would have returned.
+  bool MatchRequestFromCache(const AdBlockRequest& request,
+                             AdBlockMatchResult* result,
+                             bool* matched);
   void AddResources(const std::string& resources);
   void EnableTag(const std::string& tag, bool enabled);
   bool TagExists(const std::string& tag);
 
-  base::Optional<base::Value> UrlCosmeticResources(
+  base::Optional<CosmeticResources> UrlCosmeticResources(
           const std::string& url);
-  base::Optional<base::Value> HiddenClassIdSelectors(
+  base::Optional<std::vector<std::string>> HiddenClassIdSelectors(
           const std::vector<std::string>& classes,
           const std::vector<std::string>& ids,
           const std::vector<std::string>& exceptions);
@@ -67,6 +80,8 @@ class AdBlockBaseService : public BaseBraveShieldsService {
   void ResetForTest(const std::string& rules, const std::string& resources);
 
   std::unique_ptr<adblock::Engine> ad_block_client_;
+  // Must be invalidated whenever |ad_block_client_| changes.
+  AdBlockDecisionCache decision_cache_;
 
  private:
   void UpdateAdBlockClient(
@@ -0,0 +1,152 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_cosmetic_resources.h"
+
+#include <iterator>
+#include <utility>
+
+#include "base/json/json_reader.h"
+
+namespace brave_shields {
+
+namespace {
+
+// Moves the strings out of |list|, skipping anything that isn't a string.
+std::vector<std::string> TakeStringList(base::Value* list) {
+  std::vector<std::string> strings;
+  if (!list || !list->is_list())
+    return strings;
+  strings.reserve(list->GetList().size());
+  for (base::Value& item : list->GetList()) {
+    if (item.is_string())
+      strings.push_back(std::move(item.GetString()));
+  }
+  return strings;
+}
+
+void AppendAll(std::vector<std::string> from, std::vector<std::string>* into) {
+  if (into->empty()) {
+    *into = std::move(from);
+    return;
+  }
+  into->insert(into->end(), std::make_move_iterator(from.begin()),
+               std::make_move_iterator(from.end()));
+}
+
+base::Value StringListToValue(std::vector<std::string> strings) {
+  base::Value::ListStorage list;
+  list.reserve(strings.size());
+  for (std::string& string : strings)
+    list.emplace_back(std::move(string));
+  return base::Value(std::move(list));
+}
+
+}  // namespace
+
+CosmeticResources::CosmeticResources() {}
+
+CosmeticResources::CosmeticResources(const CosmeticResources& other) =
+    default;
+
+CosmeticResources::CosmeticResources(CosmeticResources&& other) = default;
+
+CosmeticResources& CosmeticResources::operator=(CosmeticResources&& other) =
+    default;
+
+CosmeticResources::~CosmeticResources() {}
+
+// static
+base::Optional<CosmeticResources> CosmeticResources::FromJSON(
+    base::StringPiece json) {
+  base::Optional<base::Value> value = base::JSONReader::Read(json);
+  if (!value || !value->is_dict())
+    return base::nullopt;
+
+  CosmeticResources resources;
+  resources.hide_selectors = TakeStringList(value->FindKey("hide_selectors"));
+  resources.exceptions = TakeStringList(value->FindKey("exceptions"));
+
+  base::Value* style_selectors = value->FindKey("style_selectors");
+  if (style_selectors && style_selectors->is_dict()) {
+    for (auto item : style_selectors->DictItems()) {
+      resources.style_selectors.emplace(item.first,
+                                        TakeStringList(&item.second));
+    }
+  }
+
+  std::string* injected_script = value->FindStringKey("injected_script");
+  if (injected_script)
+    resources.injected_script = std::move(*injected_script);
+
+  resources.generichide =
+      value->FindBoolKey("generichide").value_or(false);
+  return resources;
+}
+
+void CosmeticResources::MergeFrom(CosmeticResources from, bool force_hide) {
+  AppendAll(std::move(from.hide_selectors),
+            force_hide ? &force_hide_selectors : &hide_selectors);
+  AppendAll(std::move(from.force_hide_selectors), &force_hide_selectors);
+
+  for (auto& item : from.style_selectors) {
+    auto it = style_selectors.find(item.first);
+    if (it == style_selectors.end())
+      style_selectors.emplace(item.first, std::move(item.second));
+    else
+      AppendAll(std::move(item.second), &it->second);
+  }
+
+  AppendAll(std::move(from.exceptions), &exceptions);
+
+  injected_script.reserve(injected_script.size() + 1 +
+                          from.injected_script.size());
+  injected_script += '\n';
+  injected_script += from.injected_script;
+
+  generichide = generichide || from.generichide;
+}
+
+base::Value CosmeticResources::TakeAsValue() {
+  base::Value styles(base::Value::Type::DICTIONARY);
+  for (auto& item : style_selectors)
+    styles.SetKey(item.first, StringListToValue(std::move(item.second)));
+  style_selectors.clear();
+
+  base::Value value(base::Value::Type::DICTIONARY);
+  value.SetKey("hide_selectors", StringListToValue(std::move(hide_selectors)));
+  value.SetKey("force_hide_selectors",
+               StringListToValue(std::move(force_hide_selectors)));
+  value.SetKey("style_selectors", std::move(styles));
+  value.SetKey("exceptions", StringListToValue(std::move(exceptions)));
+  value.SetKey("injected_script", base::Value(std::move(injected_script)));
+  value.SetKey("generichide", base::Value(generichide));
+
+  hide_selectors.clear();
+  force_hide_selectors.clear();
+  exceptions.clear();
+  injected_script.clear();
+  generichide = false;
+  return value;
+}
+
+base::Optional<std::vector<std::string>> HiddenSelectorsFromJSON(
+    base::StringPiece json) {
+  base::Optional<base::Value> value = base::JSONReader::Read(json);
+  if (!value || !value->is_list())
+    return base::nullopt;
+  return TakeStringList(&*value);
+}
+
+void MergeHiddenSelectorsInto(std::vector<std::string> from,
+                              std::vector<std::string>* into) {
+  AppendAll(std::move(from), into);
+}
+
+base::Value HiddenSelectorsToValue(std::vector<std::string> selectors) {
+  return StringListToValue(std::move(selectors));
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,63 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_COSMETIC_RESOURCES_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_COSMETIC_RESOURCES_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/optional.h"
+#include "base/strings/string_piece.h"
+#include "base/values.h"
+
+namespace brave_shields {
+
+// The url-specific cosmetic resources returned by one or more adblock-rust
+// engines. Results from every engine are merged in this form and only
+// converted to a base::Value once, when they are handed to the extension.
+struct CosmeticResources {
+  CosmeticResources();
+  CosmeticResources(const CosmeticResources& other);
+  CosmeticResources(CosmeticResources&& other);
+  CosmeticResources& operator=(CosmeticResources&& other);
+  ~CosmeticResources();
+
+  // Parses the output of adblock::Engine::urlCosmeticResources. Returns
+  // nullopt if |json| isn't a dictionary.
+  static base::Optional<CosmeticResources> FromJSON(base::StringPiece json);
+
+  // Moves the contents of |from| into this one. If |force_hide| is true,
+  // |from|'s hide_selectors are appended to force_hide_selectors instead.
+  // Behaves the same as MergeResourcesInto.
+  void MergeFrom(CosmeticResources from, bool force_hide);
+
+  // Converts into the dictionary expected by the urlCosmeticResources
+  // extension API, leaving this object empty.
+  base::Value TakeAsValue();
+
+  std::vector<std::string> hide_selectors;
+  std::vector<std::string> force_hide_selectors;
+  std::map<std::string, std::vector<std::string>> style_selectors;
+  std::vector<std::string> exceptions;
+  std::string injected_script;
+  bool generichide = false;
+};
+
+// Parses the output of adblock::Engine::hiddenClassIdSelectors. Returns
+// nullopt if |json| isn't a list.
+base::Optional<std::vector<std::string>> HiddenSelectorsFromJSON(
+    base::StringPiece json);
+
+// Moves every selector in |from| to the end of |into|.
+void MergeHiddenSelectorsInto(std::vector<std::string> from,
+                              std::vector<std::string>* into);
+
+base::Value HiddenSelectorsToValue(std::vector<std::string> selectors);
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_COSMETIC_RESOURCES_H_
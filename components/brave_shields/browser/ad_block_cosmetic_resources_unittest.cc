@@ -0,0 +1,149 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_cosmetic_resources.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
+#include "base/strings/stringprintf.h"
+#include "brave/components/brave_shields/browser/ad_block_service_helper.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_shields {
+
+namespace {
+
+const char kNonEmptyResources[] = "{"
+    "\"hide_selectors\": [\"a\", \"b\"], "
+    "\"style_selectors\": {"
+        "\"c\": [\"color: #fff\"], "
+        "\"d\": [\"color: #000\"]"
+    "}, "
+    "\"exceptions\": [\"e\", \"f\"], "
+    "\"injected_script\": \"console.log('g')\", "
+    "\"generichide\": false"
+"}";
+
+const char kOtherResources[] = "{"
+    "\"hide_selectors\": [\"h\", \"i\"], "
+    "\"style_selectors\": {"
+        "\"c\": [\"color: #eee\"], "
+        "\"k\": [\"color: #111\"]"
+    "}, "
+    "\"exceptions\": [\"l\", \"m\"], "
+    "\"injected_script\": \"console.log('n')\", "
+    "\"generichide\": true"
+"}";
+
+// Builds the JSON adblock-rust would return for a selector-heavy page.
+std::string MakeLargeResources(int engine, int selector_count) {
+  base::Value hide_selectors(base::Value::Type::LIST);
+  base::Value exceptions(base::Value::Type::LIST);
+  base::Value style_selectors(base::Value::Type::DICTIONARY);
+  for (int i = 0; i < selector_count; ++i) {
+    hide_selectors.Append(base::Value(
+        base::StringPrintf("div.ad-banner-%d-%d > .sponsored", engine, i)));
+    if (i % 10 == 0) {
+      exceptions.Append(base::Value(base::StringPrintf("#keep-%d", i)));
+      base::Value styles(base::Value::Type::LIST);
+      styles.Append(base::Value("display: none"));
+      style_selectors.SetKey(base::StringPrintf(".styled-%d", i),
+                             std::move(styles));
+    }
+  }
+  base::Value resources(base::Value::Type::DICTIONARY);
+  resources.SetKey("hide_selectors", std::move(hide_selectors));
+  resources.SetKey("style_selectors", std::move(style_selectors));
+  resources.SetKey("exceptions", std::move(exceptions));
+  resources.SetKey("injected_script", base::Value("console.log('x')"));
+  resources.SetKey("generichide", base::Value(false));
+  std::string json;
+  base::JSONWriter::Write(resources, &json);
+  return json;
+}
+
+// The pipeline used before CosmeticResources: every engine's result is
+// parsed into a base::Value and merged Value by Value.
+base::Value MergeAsValues(const std::vector<std::string>& jsons) {
+  base::Value merged = *base::JSONReader::Read(jsons[0]);
+  for (size_t i = 1; i < jsons.size(); ++i) {
+    MergeResourcesInto(*base::JSONReader::Read(jsons[i]), &merged,
+                       /*force_hide=*/i == jsons.size() - 1);
+  }
+  return merged;
+}
+
+base::Value MergeStructured(const std::vector<std::string>& jsons) {
+  base::Optional<CosmeticResources> merged =
+      CosmeticResources::FromJSON(jsons[0]);
+  for (size_t i = 1; i < jsons.size(); ++i) {
+    merged->MergeFrom(*CosmeticResources::FromJSON(jsons[i]),
+                      /*force_hide=*/i == jsons.size() - 1);
+  }
+  return merged->TakeAsValue();
+}
+
+}  // namespace
+
+TEST(CosmeticResourcesTest, ParsesEngineJSON) {
+  base::Optional<CosmeticResources> resources =
+      CosmeticResources::FromJSON(kNonEmptyResources);
+  ASSERT_TRUE(resources);
+  EXPECT_EQ(std::vector<std::string>({"a", "b"}), resources->hide_selectors);
+  EXPECT_TRUE(resources->force_hide_selectors.empty());
+  ASSERT_EQ(2u, resources->style_selectors.size());
+  EXPECT_EQ(std::vector<std::string>({"color: #fff"}),
+            resources->style_selectors["c"]);
+  EXPECT_EQ(std::vector<std::string>({"e", "f"}), resources->exceptions);
+  EXPECT_EQ("console.log('g')", resources->injected_script);
+  EXPECT_FALSE(resources->generichide);
+
+  EXPECT_FALSE(CosmeticResources::FromJSON("[]"));
+  EXPECT_FALSE(CosmeticResources::FromJSON("not json"));
+}
+
+TEST(CosmeticResourcesTest, MergeMatchesValueMerge) {
+  for (bool force_hide : {false, true}) {
+    base::Value expected = *base::JSONReader::Read(kNonEmptyResources);
+    MergeResourcesInto(*base::JSONReader::Read(kOtherResources), &expected,
+                       force_hide);
+    if (!force_hide)
+      expected.SetKey("force_hide_selectors", base::ListValue());
+
+    base::Optional<CosmeticResources> resources =
+        CosmeticResources::FromJSON(kNonEmptyResources);
+    resources->MergeFrom(*CosmeticResources::FromJSON(kOtherResources),
+                         force_hide);
+    EXPECT_EQ(expected, resources->TakeAsValue()) << force_hide;
+  }
+}
+
+TEST(CosmeticResourcesTest, HiddenSelectors) {
+  base::Optional<std::vector<std::string>> selectors =
+      HiddenSelectorsFromJSON("[\".a\", \"#b\"]");
+  ASSERT_TRUE(selectors);
+  MergeHiddenSelectorsInto({".c"}, &*selectors);
+  EXPECT_EQ(*base::JSONReader::Read("[\".a\", \"#b\", \".c\"]"),
+            HiddenSelectorsToValue(std::move(*selectors)));
+  EXPECT_FALSE(HiddenSelectorsFromJSON("{}"));
+}
+
+// Checks that merging the results of a default, several regional and a
+// custom engine as structs matches merging them as base::Values.
+TEST(CosmeticResourcesTest, StructuredMergeMatchesValueMerge) {
+  const int kEngineCount = 6;
+  const int kSelectorCount = 5000;
+  std::vector<std::string> jsons;
+  for (int i = 0; i < kEngineCount; ++i)
+    jsons.push_back(MakeLargeResources(i, kSelectorCount));
+
+  EXPECT_EQ(MergeAsValues(jsons), MergeStructured(jsons));
+}
+
+}  // namespace brave_shields
@@ -56,6 +56,7 @@ bool AdBlockCustomFiltersService::UpdateCustomFilters(
 void AdBlockCustomFiltersService::UpdateCustomFiltersOnFileTaskRunner(
     const std::string& custom_filters) {
   DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+  decision_cache_.Invalidate();
   ad_block_client_.reset(new adblock::Engine(custom_filters.c_str()));
 }
 
@@ -0,0 +1,76 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_decision_cache.h"
+
+#include "base/metrics/histogram_macros.h"
+
+namespace brave_shields {
+
+AdBlockDecisionCache::Entry::Entry(const AdBlockRequest& request,
+                                   const AdBlockMatchResult& result)
+    : url_spec(request.url_spec),
+      tab_host(request.tab_host),
+      resource_type(request.resource_type),
+      result(result) {}
+
+AdBlockDecisionCache::Entry::Entry(const Entry& other) = default;
+
+AdBlockDecisionCache::Entry::~Entry() {}
+
+bool AdBlockDecisionCache::Entry::IsFor(const AdBlockRequest& request) const {
+  return url_spec == request.url_spec && tab_host == request.tab_host &&
+         resource_type == request.resource_type;
+}
+
+AdBlockDecisionCache::AdBlockDecisionCache(size_t size)
+    : generation_(0), data_(size) {}
+
+AdBlockDecisionCache::~AdBlockDecisionCache() {}
+
+bool AdBlockDecisionCache::Get(const AdBlockRequest& request,
+                               AdBlockMatchResult* result,
+                               uint64_t* generation) {
+  base::AutoLock lock(lock_);
+  auto it = data_.Get(request.cache_key);
+  bool hit = it != data_.end() && it->second.IsFor(request);
+  UMA_HISTOGRAM_BOOLEAN("Brave.Shields.AdBlockDecisionCacheHit", hit);
+  if (hit) {
+    *result = it->second.result;
+  } else {
+    *generation = generation_;
+  }
+  return hit;
+}
+
+bool AdBlockDecisionCache::Peek(const AdBlockRequest& request,
+                                AdBlockMatchResult* result) {
+  base::AutoLock lock(lock_);
+  auto it = data_.Peek(request.cache_key);
+  if (it == data_.end() || !it->second.IsFor(request)) {
+    return false;
+  }
+  *result = it->second.result;
+  return true;
+}
+
+void AdBlockDecisionCache::Put(const AdBlockRequest& request,
+                               const AdBlockMatchResult& result,
+                               uint64_t generation) {
+  base::AutoLock lock(lock_);
+  if (generation != generation_) {
+    return;
+  }
+  // A colliding request replaces the entry it collides with.
+  data_.Put(request.cache_key, Entry(request, result));
+}
+
+void AdBlockDecisionCache::Invalidate() {
+  base::AutoLock lock(lock_);
+  ++generation_;
+  data_.Clear();
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,70 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_DECISION_CACHE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_DECISION_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+
+#include "base/containers/mru_cache.h"
+#include "base/macros.h"
+#include "base/synchronization/lock.h"
+#include "brave/components/brave_shields/browser/ad_block_request_matcher.h"
+
+namespace brave_shields {
+
+// A bounded cache of the decisions a single ad-block engine made for
+// (url, resource type, tab host) requests. Pages tend to issue the same
+// request many times, so this saves running the engine for repeats. Entries
+// are hashed on AdBlockRequest::cache_key and keep the full request so that
+// hash collisions are never answered with another request's decision.
+// Callers must Invalidate() the cache whenever the engine, its tags or its
+// resources change; decisions computed against an engine generation that has
+// since been invalidated are never stored.
+class AdBlockDecisionCache {
+ public:
+  explicit AdBlockDecisionCache(size_t size = 1000);
+  ~AdBlockDecisionCache();
+
+  // Returns true and fills |result| on a hit. On a miss, |generation| is set
+  // to the engine generation the caller's decision should be stored under.
+  bool Get(const AdBlockRequest& request,
+           AdBlockMatchResult* result,
+           uint64_t* generation);
+  // Same as Get, but doesn't count towards the hit rate histogram. Safe to
+  // call from any thread.
+  bool Peek(const AdBlockRequest& request, AdBlockMatchResult* result);
+  void Put(const AdBlockRequest& request,
+           const AdBlockMatchResult& result,
+           uint64_t generation);
+  void Invalidate();
+
+ private:
+  struct Entry {
+    Entry(const AdBlockRequest& request, const AdBlockMatchResult& result);
+    Entry(const Entry& other);
+    ~Entry();
+
+    bool IsFor(const AdBlockRequest& request) const;
+
+    std::string url_spec;
+    std::string tab_host;
+    std::string resource_type;
+    AdBlockMatchResult result;
+  };
+
+  base::Lock lock_;
+  uint64_t generation_;
+  base::HashingMRUCache<size_t, Entry> data_;
+
+  DISALLOW_COPY_AND_ASSIGN(AdBlockDecisionCache);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_DECISION_CACHE_H_
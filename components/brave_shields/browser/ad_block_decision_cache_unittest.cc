@@ -0,0 +1,156 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_decision_cache.h"
+
+#include "base/test/metrics/histogram_tester.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace brave_shields {
+
+namespace {
+
+const char kCacheHitHistogramName[] = "Brave.Shields.AdBlockDecisionCacheHit";
+
+}  // namespace
+
+TEST(AdBlockDecisionCacheTest, HitAfterPut) {
+  base::HistogramTester histogram_tester;
+  AdBlockDecisionCache cache;
+  AdBlockRequest request(GURL("https://ads.example.com/sprite.png"),
+                         blink::mojom::ResourceType::kImage, "brave.com");
+
+  AdBlockMatchResult result;
+  uint64_t generation;
+  EXPECT_FALSE(cache.Get(request, &result, &generation));
+
+  AdBlockMatchResult blocked;
+  blocked.did_match_rule = true;
+  blocked.mock_data_url = "data:image/png;base64,";
+  cache.Put(request, blocked, generation);
+
+  EXPECT_TRUE(cache.Get(request, &result, &generation));
+  EXPECT_TRUE(result.did_match_rule);
+  EXPECT_EQ("data:image/png;base64,", result.mock_data_url);
+
+  histogram_tester.ExpectBucketCount(kCacheHitHistogramName, false, 1);
+  histogram_tester.ExpectBucketCount(kCacheHitHistogramName, true, 1);
+}
+
+TEST(AdBlockDecisionCacheTest, PeekIsNotCounted) {
+  base::HistogramTester histogram_tester;
+  AdBlockDecisionCache cache;
+  AdBlockRequest request(GURL("https://ads.example.com/sprite.png"),
+                         blink::mojom::ResourceType::kImage, "brave.com");
+
+  AdBlockMatchResult result;
+  EXPECT_FALSE(cache.Peek(request, &result));
+  uint64_t generation;
+  cache.Get(request, &result, &generation);
+  result.did_match_exception = true;
+  cache.Put(request, result, generation);
+
+  AdBlockMatchResult peeked;
+  EXPECT_TRUE(cache.Peek(request, &peeked));
+  EXPECT_TRUE(peeked.did_match_exception);
+  histogram_tester.ExpectTotalCount(kCacheHitHistogramName, 1);
+}
+
+TEST(AdBlockDecisionCacheTest, KeyIncludesResourceTypeAndTabHost) {
+  AdBlockDecisionCache cache;
+  const GURL url("https://ads.example.com/pixel");
+  AdBlockRequest request(url, blink::mojom::ResourceType::kImage,
+                         "brave.com");
+
+  AdBlockMatchResult result;
+  uint64_t generation;
+  cache.Get(request, &result, &generation);
+  result.did_match_rule = true;
+  cache.Put(request, result, generation);
+
+  EXPECT_FALSE(cache.Get(
+      AdBlockRequest(url, blink::mojom::ResourceType::kScript, "brave.com"),
+      &result, &generation));
+  EXPECT_FALSE(cache.Get(
+      AdBlockRequest(url, blink::mojom::ResourceType::kImage,
+                     "news.brave.com"),
+      &result, &generation));
+}
+
+TEST(AdBlockDecisionCacheTest, HashCollisionIsAMiss) {
+  AdBlockDecisionCache cache;
+  AdBlockRequest blocked_request(GURL("https://ads.example.com/pixel"),
+                                 blink::mojom::ResourceType::kImage,
+                                 "brave.com");
+  AdBlockRequest other_request(GURL("https://cdn.example.com/logo.png"),
+                               blink::mojom::ResourceType::kImage,
+                               "brave.com");
+  other_request.cache_key = blocked_request.cache_key;
+
+  AdBlockMatchResult result;
+  uint64_t generation;
+  cache.Get(blocked_request, &result, &generation);
+  result.did_match_rule = true;
+  cache.Put(blocked_request, result, generation);
+
+  EXPECT_FALSE(cache.Get(other_request, &result, &generation));
+  EXPECT_FALSE(cache.Peek(other_request, &result));
+
+  // The colliding request's own decision replaces the entry.
+  AdBlockMatchResult allowed;
+  cache.Put(other_request, allowed, generation);
+  EXPECT_TRUE(cache.Get(other_request, &result, &generation));
+  EXPECT_FALSE(result.did_match_rule);
+  EXPECT_FALSE(cache.Get(blocked_request, &result, &generation));
+}
+
+TEST(AdBlockDecisionCacheTest, InvalidateDropsEntries) {
+  AdBlockDecisionCache cache;
+  AdBlockRequest request(GURL("https://ads.example.com/beacon"),
+                         blink::mojom::ResourceType::kPing, "brave.com");
+
+  AdBlockMatchResult result;
+  uint64_t generation;
+  cache.Get(request, &result, &generation);
+  cache.Put(request, result, generation);
+  cache.Invalidate();
+  EXPECT_FALSE(cache.Get(request, &result, &generation));
+}
+
+TEST(AdBlockDecisionCacheTest, StaleDecisionIsNotStored) {
+  AdBlockDecisionCache cache;
+  AdBlockRequest request(GURL("https://ads.example.com/beacon"),
+                         blink::mojom::ResourceType::kPing, "brave.com");
+
+  AdBlockMatchResult result;
+  uint64_t generation;
+  EXPECT_FALSE(cache.Get(request, &result, &generation));
+  // The engine changes while the decision is being computed.
+  cache.Invalidate();
+  cache.Put(request, result, generation);
+  EXPECT_FALSE(cache.Get(request, &result, &generation));
+}
+
+TEST(AdBlockDecisionCacheTest, Bounded) {
+  AdBlockDecisionCache cache(2);
+  AdBlockRequest first(GURL("https://a.example.com/"),
+                       blink::mojom::ResourceType::kImage, "brave.com");
+  AdBlockRequest second(GURL("https://b.example.com/"),
+                        blink::mojom::ResourceType::kImage, "brave.com");
+  AdBlockRequest third(GURL("https://c.example.com/"),
+                       blink::mojom::ResourceType::kImage, "brave.com");
+
+  AdBlockMatchResult result;
+  uint64_t generation = 0;
+  cache.Put(first, result, generation);
+  cache.Put(second, result, generation);
+  cache.Put(third, result, generation);
+  EXPECT_FALSE(cache.Get(first, &result, &generation));
+  EXPECT_TRUE(cache.Get(second, &result, &generation));
+  EXPECT_TRUE(cache.Get(third, &result, &generation));
+}
+
+}  // namespace brave_shields
@@ -15,6 +15,7 @@
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/brave_shields/browser/ad_block_regional_service.h"
+#include "brave/components/brave_shields/browser/ad_block_request_matcher.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "brave/components/brave_shields/browser/ad_block_service_helper.h"
 #include "brave/vendor/adblock_rust_ffi/src/wrapper.hpp"
@@ -130,18 +131,55 @@ bool AdBlockRegionalServiceManager::ShouldStartRequest(
     bool* matching_exception_filter,
     bool* cancel_request_explicitly,
     std::string* mock_data_url) {
+  AdBlockMatchResult result;
+  MatchRequest(AdBlockRequest(url, resource_type, tab_host), &result);
+  if (matching_exception_filter) {
+    *matching_exception_filter = result.did_match_exception;
+  }
+  if (result.did_match_rule) {
+    if (cancel_request_explicitly) {
+      *cancel_request_explicitly = result.cancel_request_explicitly;
+    }
+    if (mock_data_url) {
+      *mock_data_url = std::move(result.mock_data_url);
+    }
+    return false;
+  }
+
+  return true;
+}
+
+bool AdBlockRegionalServiceManager::MatchRequest(
+    const AdBlockRequest& request,
+    AdBlockMatchResult* result) {
   base::AutoLock lock(regional_services_lock_);
   for (const auto& regional_service : regional_services_) {
-    if (!regional_service.second->ShouldStartRequest(
-            url, resource_type, tab_host, matching_exception_filter,
-            cancel_request_explicitly, mock_data_url)) {
+    if (regional_service.second->MatchRequest(request, result)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool AdBlockRegionalServiceManager::MatchRequestFromCache(
+    const AdBlockRequest& request,
+    AdBlockMatchResult* result,
+    bool* matched) {
+  // |regional_services_| is only modified on the UI thread, so it can be read
+  // here without waiting for an engine match holding the lock.
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  for (const auto& regional_service : regional_services_) {
+    if (!regional_service.second->MatchRequestFromCache(request, result,
+                                                        matched)) {
       return false;
     }
-    if (matching_exception_filter && *matching_exception_filter) {
+    if (*matched) {
       return true;
     }
   }
 
+  *matched = false;
   return true;
 }
 
@@ -163,6 +201,7 @@ void AdBlockRegionalServiceManager::AddResources(
 
 void AdBlockRegionalServiceManager::EnableFilterList(
     const std::string& uuid, bool enabled) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
   DCHECK(!uuid.empty());
   auto catalog_entry = brave_shields::FindAdBlockFilterListByUUID(
       regional_catalog_, uuid);
@@ -194,62 +233,45 @@ void AdBlockRegionalServiceManager::EnableFilterList(
                      base::Unretained(this), uuid, enabled));
 }
 
-base::Optional<base::Value>
+base::Optional<CosmeticResources>
 AdBlockRegionalServiceManager::UrlCosmeticResources(
         const std::string& url) {
   base::AutoLock lock(regional_services_lock_);
-  auto it = regional_services_.begin();
-  if (it == regional_services_.end()) {
-    return base::Optional<base::Value>();
-  }
-  base::Optional<base::Value> first_value =
-      it->second->UrlCosmeticResources(url);
-
-  for ( ; it != regional_services_.end(); it++) {
-    base::Optional<base::Value> next_value =
-        it->second->UrlCosmeticResources(url);
-    if (first_value) {
-      if (next_value) {
-        MergeResourcesInto(std::move(*next_value), &*first_value, false);
-      }
-    } else {
-      first_value = std::move(next_value);
-    }
+  base::Optional<CosmeticResources> merged;
+  for (const auto& regional_service : regional_services_) {
+    base::Optional<CosmeticResources> next =
+        regional_service.second->UrlCosmeticResources(url);
+    if (!next)
+      continue;
+    if (merged)
+      merged->MergeFrom(std::move(*next), /*force_hide=*/false);
+    else
+      merged = std::move(next);
   }
 
-  return first_value;
+  return merged;
 }
 
-base::Optional<base::Value>
+base::Optional<std::vector<std::string>>
 AdBlockRegionalServiceManager::HiddenClassIdSelectors(
         const std::vector<std::string>& classes,
         const std::vector<std::string>& ids,
         const std::vector<std::string>& exceptions) {
   base::AutoLock lock(regional_services_lock_);
-  auto it = regional_services_.begin();
-  if (it == regional_services_.end()) {
-    return base::Optional<base::Value>();
-  }
-  base::Optional<base::Value> first_value =
-      it->second->HiddenClassIdSelectors(classes, ids, exceptions);
-
-  for ( ; it != regional_services_.end(); it++) {
-    base::Optional<base::Value> next_value =
-        it->second->HiddenClassIdSelectors(classes, ids, exceptions);
-    if (first_value && first_value->is_list()) {
-      if (next_value && next_value->is_list()) {
-        for (auto i = next_value->GetList().begin();
-                i < next_value->GetList().end();
-                i++) {
-          first_value->Append(std::move(*i));
-        }
-      }
-    } else {
-      first_value = std::move(next_value);
-    }
+  base::Optional<std::vector<std::string>> merged;
+  for (const auto& regional_service : regional_services_) {
+    base::Optional<std::vector<std::string>> next =
+        regional_service.second->HiddenClassIdSelectors(classes, ids,
+                                                        exceptions);
+    if (!next)
+      continue;
+    if (merged)
+      MergeHiddenSelectorsInto(std::move(*next), &*merged);
+    else
+      merged = std::move(next);
   }
 
-  return first_value;
+  return merged;
 }
 
 void AdBlockRegionalServiceManager::SetRegionalCatalog(
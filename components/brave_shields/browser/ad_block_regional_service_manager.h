@@ -17,6 +17,7 @@
 #include "base/synchronization/lock.h"
 #include "base/values.h"
 #include "brave/components/brave_component_updater/browser/brave_component.h"
+#include "brave/components/brave_shields/browser/ad_block_cosmetic_resources.h"
 #include "brave/vendor/adblock_rust_ffi/src/wrapper.hpp"
 #include "third_party/blink/public/mojom/loader/resource_load_info.mojom-shared.h"
 #include "url/gurl.h"
@@ -32,6 +33,8 @@ using brave_component_updater::BraveComponent;
 namespace brave_shields {
 
 class AdBlockRegionalService;
+struct AdBlockMatchResult;
+struct AdBlockRequest;
 
 // The AdBlock regional service manager, in charge of initializing and
 // managing regional AdBlock clients.
@@ -53,13 +56,21 @@ class AdBlockRegionalServiceManager {
                           bool* matching_exception_filter,
                           bool* cancel_request_explicitly,
                           std::string* mock_data_url);
+  // Runs |request| through every enabled regional engine, in a stable order,
+  // stopping at the first blocking or exception match. Returns true if such a
+  // match was found.
+  bool MatchRequest(const AdBlockRequest& request, AdBlockMatchResult* result);
+  // See AdBlockBaseService::MatchRequestFromCache.
+  bool MatchRequestFromCache(const AdBlockRequest& request,
+                             AdBlockMatchResult* result,
+                             bool* matched);
   void EnableTag(const std::string& tag, bool enabled);
   void AddResources(const std::string& resources);
   void EnableFilterList(const std::string& uuid, bool enabled);
 
-  base::Optional<base::Value> UrlCosmeticResources(
+  base::Optional<CosmeticResources> UrlCosmeticResources(
           const std::string& url);
-  base::Optional<base::Value> HiddenClassIdSelectors(
+  base::Optional<std::vector<std::string>> HiddenClassIdSelectors(
           const std::vector<std::string>& classes,
           const std::vector<std::string>& ids,
           const std::vector<std::string>& exceptions);
@@ -72,6 +83,8 @@ class AdBlockRegionalServiceManager {
 
   brave_component_updater::BraveComponent::Delegate* delegate_;  // NOT OWNED
   bool initialized_;
+  // Held to modify |regional_services_| on the UI thread, and to read it
+  // anywhere else.
   base::Lock regional_services_lock_;
   std::map<std::string, std::unique_ptr<AdBlockRegionalService>>
       regional_services_;
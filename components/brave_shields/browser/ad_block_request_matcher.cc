@@ -0,0 +1,145 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_request_matcher.h"
+
+#include <functional>
+
+#include "base/hash/hash.h"
+#include "base/logging.h"
+#include "brave/vendor/adblock_rust_ffi/src/wrapper.hpp"
+#include "net/base/registry_controlled_domains/registry_controlled_domain.h"
+#include "url/gurl.h"
+#include "url/origin.h"
+
+using namespace net::registry_controlled_domains;  // NOLINT
+
+namespace brave_shields {
+
+std::string ResourceTypeToString(blink::mojom::ResourceType resource_type) {
+  std::string filter_option = "";
+  switch (resource_type) {
+    // top level page
+    case blink::mojom::ResourceType::kMainFrame:
+      filter_option = "main_frame";
+      break;
+    // frame or iframe
+    case blink::mojom::ResourceType::kSubFrame:
+      filter_option = "sub_frame";
+      break;
+    // a CSS stylesheet
+    case blink::mojom::ResourceType::kStylesheet:
+      filter_option = "stylesheet";
+      break;
+    // an external script
+    case blink::mojom::ResourceType::kScript:
+      filter_option = "script";
+      break;
+    // an image (jpg/gif/png/etc)
+    case blink::mojom::ResourceType::kFavicon:
+    case blink::mojom::ResourceType::kImage:
+      filter_option = "image";
+      break;
+    // a font
+    case blink::mojom::ResourceType::kFontResource:
+      filter_option = "font";
+      break;
+    // an "other" subresource.
+    case blink::mojom::ResourceType::kSubResource:
+      filter_option = "other";
+      break;
+    // an object (or embed) tag for a plugin.
+    case blink::mojom::ResourceType::kObject:
+      filter_option = "object";
+      break;
+    // a media resource.
+    case blink::mojom::ResourceType::kMedia:
+      filter_option = "media";
+      break;
+    // a XMLHttpRequest
+    case blink::mojom::ResourceType::kXhr:
+      filter_option = "xhr";
+      break;
+    // a ping request for <a ping>/sendBeacon.
+    case blink::mojom::ResourceType::kPing:
+      filter_option = "ping";
+      break;
+    // the main resource of a dedicated worker.
+    case blink::mojom::ResourceType::kWorker:
+    // the main resource of a shared worker.
+    case blink::mojom::ResourceType::kSharedWorker:
+    // an explicitly requested prefetch
+    case blink::mojom::ResourceType::kPrefetch:
+    // the main resource of a service worker.
+    case blink::mojom::ResourceType::kServiceWorker:
+    // a report of Content Security Policy violations.
+    case blink::mojom::ResourceType::kCspReport:
+    // a resource that a plugin requested.
+    case blink::mojom::ResourceType::kPluginResource:
+    default:
+      break;
+  }
+  return filter_option;
+}
+
+AdBlockRequest::AdBlockRequest(const GURL& url,
+                               blink::mojom::ResourceType resource_type,
+                               const std::string& tab_host)
+    : url_spec(url.spec()),
+      url_host(url.host()),
+      tab_host(tab_host),
+      resource_type(ResourceTypeToString(resource_type)) {
+  // Determine third-party here so the library doesn't need to figure it out.
+  // CreateFromNormalizedTuple is needed because SameDomainOrHost needs
+  // a URL or origin and not a string to a host name.
+  is_third_party = !SameDomainOrHost(
+      url,
+      url::Origin::CreateFromNormalizedTuple("https", tab_host.c_str(), 80),
+      INCLUDE_PRIVATE_REGISTRIES);
+  // The full tab host is part of the key rather than its eTLD+1 since
+  // $domain= options can target individual subdomains.
+  std::hash<std::string> hasher;
+  cache_key = base::HashInts(
+      hasher(url_spec), base::HashInts(hasher(this->tab_host),
+                                       hasher(this->resource_type)));
+}
+
+AdBlockRequest::AdBlockRequest(const AdBlockRequest& other) = default;
+
+AdBlockRequest::~AdBlockRequest() {}
+
+AdBlockMatchResult::AdBlockMatchResult() {}
+
+AdBlockMatchResult::AdBlockMatchResult(const AdBlockMatchResult& other) =
+    default;
+
+AdBlockMatchResult& AdBlockMatchResult::operator=(
+    const AdBlockMatchResult& other) = default;
+
+AdBlockMatchResult::~AdBlockMatchResult() {}
+
+bool MatchAdBlockRequest(adblock::Engine* engine,
+                         const AdBlockRequest& request,
+                         AdBlockMatchResult* result) {
+  DCHECK(engine);
+  DCHECK(result);
+  bool explicit_cancel = false;
+  bool saved_from_exception = false;
+  if (engine->matches(request.url_spec, request.url_host, request.tab_host,
+                      request.is_third_party, request.resource_type,
+                      &explicit_cancel, &saved_from_exception,
+                      &result->mock_data_url)) {
+    result->did_match_rule = true;
+    result->cancel_request_explicitly = explicit_cancel;
+    // We'd only possibly match an exception filter if we're returning true.
+    result->did_match_exception = false;
+    return true;
+  }
+
+  result->did_match_exception = saved_from_exception;
+  return saved_from_exception;
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,69 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_REQUEST_MATCHER_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_REQUEST_MATCHER_H_
+
+#include <stddef.h>
+
+#include <string>
+
+#include "third_party/blink/public/mojom/loader/resource_load_info.mojom-shared.h"
+
+class GURL;
+
+namespace adblock {
+class Engine;
+}
+
+namespace brave_shields {
+
+std::string ResourceTypeToString(blink::mojom::ResourceType resource_type);
+
+// The inputs adblock-rust needs for a single request. Computed once per
+// request so that the default, regional and custom filter engines all share
+// the same third-party check and string conversions.
+struct AdBlockRequest {
+  AdBlockRequest(const GURL& url,
+                 blink::mojom::ResourceType resource_type,
+                 const std::string& tab_host);
+  AdBlockRequest(const AdBlockRequest& other);
+  ~AdBlockRequest();
+
+  std::string url_spec;
+  std::string url_host;
+  std::string tab_host;
+  std::string resource_type;
+  bool is_third_party;
+  // Hash of the url, tab host and resource type, which together identify
+  // requests that every engine answers identically. Used by
+  // AdBlockDecisionCache, which compares the full request on a hit.
+  size_t cache_key;
+};
+
+// The accumulated outcome of running an AdBlockRequest through one or more
+// engines.
+struct AdBlockMatchResult {
+  AdBlockMatchResult();
+  AdBlockMatchResult(const AdBlockMatchResult& other);
+  AdBlockMatchResult& operator=(const AdBlockMatchResult& other);
+  ~AdBlockMatchResult();
+
+  bool did_match_rule = false;
+  bool did_match_exception = false;
+  bool cancel_request_explicitly = false;
+  std::string mock_data_url;
+};
+
+// Runs |request| through |engine| and records the outcome in |result|.
+// Returns true if no further engine needs to be consulted, i.e. the request
+// matched either a blocking rule or an exception rule.
+bool MatchAdBlockRequest(adblock::Engine* engine,
+                         const AdBlockRequest& request,
+                         AdBlockMatchResult* result);
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_REQUEST_MATCHER_H_
@@ -0,0 +1,191 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_request_matcher.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/strings/stringprintf.h"
+#include "brave/vendor/adblock_rust_ffi/src/wrapper.hpp"
+#include "net/base/registry_controlled_domains/registry_controlled_domain.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+#include "url/origin.h"
+
+using namespace net::registry_controlled_domains;  // NOLINT
+
+namespace brave_shields {
+
+namespace {
+
+// AdBlockBaseService::ShouldStartRequest() as it was before AdBlockRequest
+// existed: every engine re-derives the third-party status and the string
+// inputs. Returns false if the request should be blocked.
+bool ShouldStartRequestWithoutAdBlockRequest(
+    adblock::Engine* engine,
+    const GURL& url,
+    blink::mojom::ResourceType resource_type,
+    const std::string& tab_host,
+    bool* did_match_exception,
+    bool* cancel_request_explicitly,
+    std::string* mock_data_url) {
+  bool is_third_party = !SameDomainOrHost(
+      url,
+      url::Origin::CreateFromNormalizedTuple("https", tab_host.c_str(), 80),
+      INCLUDE_PRIVATE_REGISTRIES);
+  bool explicit_cancel;
+  bool saved_from_exception;
+  if (engine->matches(url.spec(), url.host(), tab_host, is_third_party,
+                      ResourceTypeToString(resource_type), &explicit_cancel,
+                      &saved_from_exception, mock_data_url)) {
+    *cancel_request_explicitly = explicit_cancel;
+    *did_match_exception = false;
+    return false;
+  }
+  *did_match_exception = saved_from_exception;
+  return true;
+}
+
+// The chain the network delegate helper used to run: each engine in turn,
+// stopping at the first one that blocks the request or matches an
+// exception.
+AdBlockMatchResult MatchSequentially(
+    const std::vector<std::unique_ptr<adblock::Engine>>& engines,
+    const GURL& url,
+    blink::mojom::ResourceType resource_type,
+    const std::string& tab_host) {
+  AdBlockMatchResult result;
+  for (const auto& engine : engines) {
+    std::string mock_data_url;
+    if (!ShouldStartRequestWithoutAdBlockRequest(
+            engine.get(), url, resource_type, tab_host,
+            &result.did_match_exception, &result.cancel_request_explicitly,
+            &mock_data_url)) {
+      result.did_match_rule = true;
+      result.mock_data_url = mock_data_url;
+      break;
+    }
+    if (result.did_match_exception)
+      break;
+  }
+  return result;
+}
+
+AdBlockMatchResult MatchComposite(
+    const std::vector<std::unique_ptr<adblock::Engine>>& engines,
+    const AdBlockRequest& request) {
+  AdBlockMatchResult result;
+  for (const auto& engine : engines) {
+    if (MatchAdBlockRequest(engine.get(), request, &result))
+      break;
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST(AdBlockRequestMatcherTest, TokenizesRequestOnce) {
+  AdBlockRequest first_party(GURL("https://cdn.brave.com/logo.png"),
+                             blink::mojom::ResourceType::kImage,
+                             "www.brave.com");
+  EXPECT_EQ("https://cdn.brave.com/logo.png", first_party.url_spec);
+  EXPECT_EQ("cdn.brave.com", first_party.url_host);
+  EXPECT_EQ("www.brave.com", first_party.tab_host);
+  EXPECT_EQ("image", first_party.resource_type);
+  EXPECT_FALSE(first_party.is_third_party);
+
+  AdBlockRequest third_party(GURL("https://tracker.example.com/p.js"),
+                             blink::mojom::ResourceType::kScript,
+                             "www.brave.com");
+  EXPECT_EQ("script", third_party.resource_type);
+  EXPECT_TRUE(third_party.is_third_party);
+}
+
+TEST(AdBlockRequestMatcherTest, ExceptionStopsLaterEngines) {
+  adblock::Engine allowing("||example.com/ads/*\n@@||example.com/ads/ok.js");
+  adblock::Engine blocking("||example.com/ads/*");
+  AdBlockRequest request(GURL("https://example.com/ads/ok.js"),
+                         blink::mojom::ResourceType::kScript, "brave.com");
+
+  AdBlockMatchResult result;
+  EXPECT_TRUE(MatchAdBlockRequest(&allowing, request, &result));
+  EXPECT_FALSE(result.did_match_rule);
+  EXPECT_TRUE(result.did_match_exception);
+
+  // Without the exception the first blocking engine wins.
+  AdBlockMatchResult blocked_result;
+  EXPECT_TRUE(MatchAdBlockRequest(&blocking, request, &blocked_result));
+  EXPECT_TRUE(blocked_result.did_match_rule);
+  EXPECT_FALSE(blocked_result.did_match_exception);
+}
+
+TEST(AdBlockRequestMatcherTest, NoMatchContinues) {
+  adblock::Engine engine("||example.com/ads/*");
+  AdBlockRequest request(GURL("https://brave.com/index.js"),
+                         blink::mojom::ResourceType::kScript, "brave.com");
+  AdBlockMatchResult result;
+  EXPECT_FALSE(MatchAdBlockRequest(&engine, request, &result));
+  EXPECT_FALSE(result.did_match_rule);
+  EXPECT_FALSE(result.did_match_exception);
+}
+
+// Checks that the single-pass matcher gives the same decisions as the
+// previous per-engine chain, with the number of lists a user with several
+// regional lists would have.
+TEST(AdBlockRequestMatcherTest, CompositeMatchesSequentialChain) {
+  const int kEngineCount = 8;
+  std::vector<std::unique_ptr<adblock::Engine>> engines;
+  for (int i = 0; i < kEngineCount; ++i) {
+    engines.push_back(std::make_unique<adblock::Engine>(base::StringPrintf(
+        "||ads%d.example.com^\n"
+        "/banner%d/*$image\n"
+        "@@||ads%d.example.com/ok^\n"
+        "||tracker%d.example.com^$third-party\n"
+        // Excepted here, but blocked by the next engine.
+        "@@||ads%d.example.com/later^",
+        i, i, i, i, i + 1)));
+  }
+
+  std::vector<GURL> urls;
+  for (int i = 0; i < kEngineCount + 2; ++i) {
+    urls.push_back(GURL(
+        base::StringPrintf("https://ads%d.example.com/script.js", i)));
+    urls.push_back(GURL(
+        base::StringPrintf("https://ads%d.example.com/ok/script.js", i)));
+    urls.push_back(GURL(
+        base::StringPrintf("https://ads%d.example.com/later/script.js", i)));
+    urls.push_back(GURL(
+        base::StringPrintf("https://cdn.brave.com/banner%d/a.png", i)));
+    urls.push_back(GURL(
+        base::StringPrintf("https://tracker%d.example.com/t.js", i)));
+  }
+  const std::string tab_hosts[] = {"brave.com", "www.tracker3.example.com"};
+  const blink::mojom::ResourceType resource_types[] = {
+      blink::mojom::ResourceType::kImage, blink::mojom::ResourceType::kScript};
+
+  for (const GURL& url : urls) {
+    for (const std::string& tab_host : tab_hosts) {
+      for (blink::mojom::ResourceType resource_type : resource_types) {
+        const AdBlockMatchResult expected =
+            MatchSequentially(engines, url, resource_type, tab_host);
+        const AdBlockMatchResult actual = MatchComposite(
+            engines, AdBlockRequest(url, resource_type, tab_host));
+        SCOPED_TRACE(url.spec() + " on " + tab_host + " as " +
+                     ResourceTypeToString(resource_type));
+        EXPECT_EQ(expected.did_match_rule, actual.did_match_rule);
+        EXPECT_EQ(expected.did_match_exception, actual.did_match_exception);
+        if (expected.did_match_rule) {
+          EXPECT_EQ(expected.cancel_request_explicitly,
+                    actual.cancel_request_explicitly);
+          EXPECT_EQ(expected.mock_data_url, actual.mock_data_url);
+        }
+      }
+    }
+  }
+}
+
+}  // namespace brave_shields
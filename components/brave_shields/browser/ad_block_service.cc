@@ -21,6 +21,7 @@
 #include "brave/common/pref_names.h"
 #include "brave/components/brave_shields/browser/ad_block_custom_filters_service.h"
 #include "brave/components/brave_shields/browser/ad_block_regional_service_manager.h"
+#include "brave/components/brave_shields/browser/ad_block_request_matcher.h"
 #include "brave/components/brave_shields/browser/ad_block_service_helper.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "brave/vendor/adblock_rust_ffi/src/wrapper.hpp"
@@ -89,6 +90,34 @@ AdBlockService::custom_filters_service() {
   return custom_filters_service_.get();
 }
 
+bool AdBlockService::MatchAllEngines(const AdBlockRequest& request,
+                                     AdBlockMatchResult* result) {
+  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+  return MatchRequest(request, result) ||
+         regional_service_manager()->MatchRequest(request, result) ||
+         custom_filters_service()->MatchRequest(request, result);
+}
+
+bool AdBlockService::MatchAllEnginesFromCache(const AdBlockRequest& request,
+                                              AdBlockMatchResult* result) {
+  bool matched = false;
+  if (!MatchRequestFromCache(request, result, &matched)) {
+    return false;
+  }
+  if (matched) {
+    return true;
+  }
+  if (!regional_service_manager()->MatchRequestFromCache(request, result,
+                                                         &matched)) {
+    return false;
+  }
+  if (matched) {
+    return true;
+  }
+  return custom_filters_service()->MatchRequestFromCache(request, result,
+                                                         &matched);
+}
+
 AdBlockService::AdBlockService(
     brave_component_updater::BraveComponent::Delegate* delegate)
     : AdBlockBaseService(delegate),
@@ -49,6 +49,19 @@ class AdBlockService : public AdBlockBaseService {
   AdBlockRegionalServiceManager* regional_service_manager();
   AdBlockCustomFiltersService* custom_filters_service();
 
+  // Runs |request| through the default, regional and custom filter engines,
+  // in that order, stopping at the first blocking or exception match.
+  // Returns true if such a match was found.
+  bool MatchAllEngines(const AdBlockRequest& request,
+                       AdBlockMatchResult* result);
+  // Same as MatchAllEngines, but only answers from decisions the engines have
+  // already cached, so it can run synchronously on the thread handling the
+  // request. Returns false if any engine that would have been consulted has
+  // no cached decision, in which case MatchAllEngines must be run on the
+  // task runner instead.
+  bool MatchAllEnginesFromCache(const AdBlockRequest& request,
+                                AdBlockMatchResult* result);
+
  protected:
   bool Init() override;
   void OnComponentReady(const std::string& component_id,
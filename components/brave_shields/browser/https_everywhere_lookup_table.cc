@@ -0,0 +1,154 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_lookup_table.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <memory>
+
+#include "base/files/file_path.h"
+#include "base/files/important_file_writer.h"
+#include "base/logging.h"
+#include "third_party/leveldatabase/src/include/leveldb/db.h"
+
+namespace brave_shields {
+
+namespace {
+
+const char kMagic[8] = {'H', 'T', 'T', 'P', 'S', 'E', 'T', '1'};
+
+struct Header {
+  char magic[8];
+  uint32_t entry_count;
+  uint32_t reserved;
+};
+
+void AppendUInt32(uint32_t value, std::string* out) {
+  out->append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+}  // namespace
+
+HTTPSELookupTable::HTTPSELookupTable()
+    : entries_(nullptr), entry_count_(0), data_(nullptr), data_size_(0) {}
+
+HTTPSELookupTable::~HTTPSELookupTable() {}
+
+// static
+bool HTTPSELookupTable::Write(const Entries& entries,
+                              const base::FilePath& path) {
+  DCHECK(std::is_sorted(entries.begin(), entries.end()));
+  std::string index;
+  std::string data;
+  for (const auto& entry : entries) {
+    AppendUInt32(data.size(), &index);
+    AppendUInt32(entry.first.size(), &index);
+    data.append(entry.first);
+    AppendUInt32(data.size(), &index);
+    AppendUInt32(entry.second.size(), &index);
+    data.append(entry.second);
+  }
+
+  std::string contents(kMagic, sizeof(kMagic));
+  AppendUInt32(entries.size(), &contents);
+  AppendUInt32(0, &contents);
+  contents.append(index);
+  contents.append(data);
+  return base::ImportantFileWriter::WriteFileAtomically(path, contents);
+}
+
+// static
+bool HTTPSELookupTable::WriteFromLevelDB(leveldb::DB* db,
+                                         const base::FilePath& path) {
+  DCHECK(db);
+  Entries entries;
+  std::unique_ptr<leveldb::Iterator> it(
+      db->NewIterator(leveldb::ReadOptions()));
+  // leveldb iterates in bytewise key order, which is what Find expects.
+  for (it->SeekToFirst(); it->Valid(); it->Next()) {
+    entries.emplace_back(it->key().ToString(), it->value().ToString());
+  }
+  if (!it->status().ok()) {
+    LOG(ERROR) << "Failed to read HTTPSE database: "
+               << it->status().ToString();
+    return false;
+  }
+  return Write(entries, path);
+}
+
+bool HTTPSELookupTable::Initialize(const base::FilePath& path) {
+  if (!file_.Initialize(path)) {
+    return false;
+  }
+
+  Header header;
+  if (file_.length() < sizeof(header)) {
+    return false;
+  }
+  memcpy(&header, file_.data(), sizeof(header));
+  if (memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+    return false;
+  }
+
+  if (header.entry_count > (file_.length() - sizeof(header)) / sizeof(Entry)) {
+    return false;
+  }
+  const size_t index_size = header.entry_count * sizeof(Entry);
+  const Entry* entries =
+      reinterpret_cast<const Entry*>(file_.data() + sizeof(header));
+  const char* data = reinterpret_cast<const char*>(file_.data()) +
+                     sizeof(header) + index_size;
+  const size_t data_size = file_.length() - sizeof(header) - index_size;
+  for (size_t i = 0; i < header.entry_count; ++i) {
+    if (entries[i].key_offset > data_size ||
+        entries[i].key_size > data_size - entries[i].key_offset ||
+        entries[i].value_offset > data_size ||
+        entries[i].value_size > data_size - entries[i].value_offset) {
+      return false;
+    }
+  }
+
+  entries_ = entries;
+  entry_count_ = header.entry_count;
+  data_ = data;
+  data_size_ = data_size;
+  return true;
+}
+
+bool HTTPSELookupTable::IsValid() const {
+  return data_ != nullptr;
+}
+
+base::StringPiece HTTPSELookupTable::Find(base::StringPiece key) const {
+  size_t low = 0;
+  size_t high = entry_count_;
+  while (low < high) {
+    const size_t middle = low + (high - low) / 2;
+    const int comparison = KeyAt(middle).compare(key);
+    if (comparison == 0) {
+      return ValueAt(middle);
+    }
+    if (comparison < 0) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return base::StringPiece();
+}
+
+base::StringPiece HTTPSELookupTable::KeyAt(size_t index) const {
+  return base::StringPiece(data_ + entries_[index].key_offset,
+                           entries_[index].key_size);
+}
+
+base::StringPiece HTTPSELookupTable::ValueAt(size_t index) const {
+  return base::StringPiece(data_ + entries_[index].value_offset,
+                           entries_[index].value_size);
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,85 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_LOOKUP_TABLE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_LOOKUP_TABLE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/files/memory_mapped_file.h"
+#include "base/macros.h"
+#include "base/strings/string_piece.h"
+
+namespace base {
+class FilePath;
+}  // namespace base
+
+namespace leveldb {
+class DB;
+}  // namespace leveldb
+
+namespace brave_shields {
+
+// A read-only, memory-mapped copy of the HTTPS Everywhere leveldb. It is
+// generated once per component version, so later startups can skip unzipping
+// and opening the leveldb and resolve lookups by binary search over the
+// mapped file instead.
+//
+// File layout, all integers in native byte order:
+//   header:  8 byte magic, uint32_t entry count, uint32_t reserved
+//   entries: entry count x {key offset, key size, value offset, value size},
+//            sorted by key, offsets relative to the start of the data block
+//   data:    the key and value bytes
+class HTTPSELookupTable {
+ public:
+  using Entries = std::vector<std::pair<std::string, std::string>>;
+
+  HTTPSELookupTable();
+  ~HTTPSELookupTable();
+
+  // Writes |entries|, which must be sorted by key, to |path|.
+  static bool Write(const Entries& entries, const base::FilePath& path);
+  // Writes every key/value pair in |db| to |path|.
+  static bool WriteFromLevelDB(leveldb::DB* db, const base::FilePath& path);
+
+  // Maps the table at |path|. Returns false if the file is missing or
+  // malformed.
+  bool Initialize(const base::FilePath& path);
+  bool IsValid() const;
+
+  // Returns the value stored under |key|, or an empty string piece if there
+  // is none. The returned data lives as long as this table.
+  base::StringPiece Find(base::StringPiece key) const;
+
+  size_t size() const { return entry_count_; }
+
+ private:
+  struct Entry {
+    uint32_t key_offset;
+    uint32_t key_size;
+    uint32_t value_offset;
+    uint32_t value_size;
+  };
+
+  base::StringPiece KeyAt(size_t index) const;
+  base::StringPiece ValueAt(size_t index) const;
+
+  base::MemoryMappedFile file_;
+  const Entry* entries_;
+  size_t entry_count_;
+  const char* data_;
+  size_t data_size_;
+
+  DISALLOW_COPY_AND_ASSIGN(HTTPSELookupTable);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_LOOKUP_TABLE_H_
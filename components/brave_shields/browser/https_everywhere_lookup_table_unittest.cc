@@ -0,0 +1,122 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_lookup_table.h"
+
+#include <memory>
+#include <string>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/strings/stringprintf.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/leveldatabase/src/include/leveldb/db.h"
+
+namespace brave_shields {
+
+class HTTPSELookupTableTest : public testing::Test {
+ public:
+  HTTPSELookupTableTest() {}
+  ~HTTPSELookupTableTest() override {}
+
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+  }
+
+  base::FilePath TablePath() const {
+    return temp_dir_.GetPath().AppendASCII("httpse.table");
+  }
+
+ protected:
+  base::ScopedTempDir temp_dir_;
+};
+
+TEST_F(HTTPSELookupTableTest, FindsKeys) {
+  HTTPSELookupTable::Entries entries = {
+      {"com.example", "[{\"r\":[{\"d\":1}]}]"},
+      {"com.example.*", "[]"},
+      {"org.brave", "value"},
+  };
+  ASSERT_TRUE(HTTPSELookupTable::Write(entries, TablePath()));
+
+  HTTPSELookupTable table;
+  ASSERT_TRUE(table.Initialize(TablePath()));
+  EXPECT_TRUE(table.IsValid());
+  EXPECT_EQ(3u, table.size());
+  EXPECT_EQ("[{\"r\":[{\"d\":1}]}]", table.Find("com.example"));
+  EXPECT_EQ("[]", table.Find("com.example.*"));
+  EXPECT_EQ("value", table.Find("org.brave"));
+  EXPECT_TRUE(table.Find("com").empty());
+  EXPECT_TRUE(table.Find("com.example.www").empty());
+  EXPECT_TRUE(table.Find("zzz").empty());
+}
+
+TEST_F(HTTPSELookupTableTest, EmptyTable) {
+  ASSERT_TRUE(
+      HTTPSELookupTable::Write(HTTPSELookupTable::Entries(), TablePath()));
+  HTTPSELookupTable table;
+  ASSERT_TRUE(table.Initialize(TablePath()));
+  EXPECT_TRUE(table.Find("com.example").empty());
+}
+
+TEST_F(HTTPSELookupTableTest, RejectsMalformedFiles) {
+  HTTPSELookupTable missing;
+  EXPECT_FALSE(missing.Initialize(TablePath()));
+  EXPECT_FALSE(missing.IsValid());
+
+  const char kGarbage[] = "not a lookup table";
+  ASSERT_TRUE(base::WriteFile(TablePath(), kGarbage, sizeof(kGarbage)));
+  HTTPSELookupTable garbage;
+  EXPECT_FALSE(garbage.Initialize(TablePath()));
+
+  // A valid header that claims more entries than the file holds.
+  HTTPSELookupTable::Entries entries = {{"com.example", "value"}};
+  ASSERT_TRUE(HTTPSELookupTable::Write(entries, TablePath()));
+  std::string contents;
+  ASSERT_TRUE(base::ReadFileToString(TablePath(), &contents));
+  contents.resize(contents.size() - 4);
+  ASSERT_TRUE(base::WriteFile(TablePath(), contents.data(), contents.size()));
+  HTTPSELookupTable truncated;
+  EXPECT_FALSE(truncated.Initialize(TablePath()));
+}
+
+// Checks that the lookup table returns the same values as the leveldb it was
+// generated from.
+TEST_F(HTTPSELookupTableTest, MatchesLevelDB) {
+  const int kEntryCount = 20000;
+  const base::FilePath db_path = temp_dir_.GetPath().AppendASCII("httpse.db");
+  {
+    leveldb::DB* db = nullptr;
+    leveldb::Options options;
+    options.create_if_missing = true;
+    ASSERT_TRUE(leveldb::DB::Open(options, db_path.AsUTF8Unsafe(), &db).ok());
+    std::unique_ptr<leveldb::DB> db_owner(db);
+    for (int i = 0; i < kEntryCount; ++i) {
+      ASSERT_TRUE(db->Put(leveldb::WriteOptions(),
+                          base::StringPrintf("com.example%d", i),
+                          base::StringPrintf("[{\"r\":[{\"d\":%d}]}]", i))
+                      .ok());
+    }
+    ASSERT_TRUE(HTTPSELookupTable::WriteFromLevelDB(db, TablePath()));
+  }
+
+  leveldb::DB* db = nullptr;
+  ASSERT_TRUE(
+      leveldb::DB::Open(leveldb::Options(), db_path.AsUTF8Unsafe(), &db).ok());
+  std::unique_ptr<leveldb::DB> db_owner(db);
+
+  HTTPSELookupTable table;
+  ASSERT_TRUE(table.Initialize(TablePath()));
+
+  EXPECT_EQ(static_cast<size_t>(kEntryCount), table.size());
+  for (int i = 0; i < kEntryCount; i += 97) {
+    const std::string key = base::StringPrintf("com.example%d", i);
+    std::string value;
+    ASSERT_TRUE(db->Get(leveldb::ReadOptions(), key, &value).ok());
+    EXPECT_EQ(value, table.Find(key));
+  }
+}
+
+}  // namespace brave_shields
@@ -5,6 +5,8 @@
 
 #include <string>
 
+#include "base/strings/string_number_conversions.h"
+#include "base/threading/simple_thread.h"
 #include "brave/components/brave_shields/browser/https_everywhere_recently_used_cache.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -28,3 +30,75 @@ TEST(HTTPSEverywhereRecentlyUsedCacheTest, Operations) {
   cache.remove("kD");
   ASSERT_FALSE(cache.get("kD", &v));
 }
+
+TEST(HTTPSEverywhereRecentlyUsedCacheTest, ShardedOperations) {
+  using Cache = HTTPSERecentlyUsedCache<std::string>;
+  Cache cache(64, 8);
+
+  for (int i = 0; i < 32; ++i) {
+    cache.add("k" + base::NumberToString(i), "v" + base::NumberToString(i));
+  }
+  std::string v;
+  for (int i = 0; i < 32; ++i) {
+    ASSERT_TRUE(cache.get("k" + base::NumberToString(i), &v));
+    ASSERT_EQ("v" + base::NumberToString(i), v);
+  }
+
+  cache.remove("k3");
+  ASSERT_FALSE(cache.get("k3", &v));
+  ASSERT_TRUE(cache.get("k4", &v));
+}
+
+namespace {
+
+class CacheLookupDelegate : public base::DelegateSimpleThread::Delegate {
+ public:
+  explicit CacheLookupDelegate(HTTPSERecentlyUsedCache<std::string>* cache)
+      : cache_(cache) {}
+
+  void Run() override {
+    std::string v;
+    for (int i = 0; i < 20000; ++i) {
+      const std::string key = "http://host" + base::NumberToString(i % 500) +
+                              ".example.com/";
+      if (!cache_->get(key, &v))
+        cache_->add(key, "https" + key.substr(4));
+    }
+  }
+
+ private:
+  HTTPSERecentlyUsedCache<std::string>* cache_;
+};
+
+void RunParallelLookups(HTTPSERecentlyUsedCache<std::string>* cache,
+                        int thread_count) {
+  CacheLookupDelegate delegate(cache);
+  base::DelegateSimpleThreadPool pool("HTTPSECacheTest", thread_count);
+  pool.Start();
+  pool.AddWork(&delegate, thread_count);
+  pool.JoinAll();
+}
+
+}  // namespace
+
+// Parallel lookups, the way the UI thread and the HTTPSE task runner share the
+// cache, must leave a striped cache with the same entries as a single lock.
+TEST(HTTPSEverywhereRecentlyUsedCacheTest, ParallelLookups) {
+  const int kThreadCount = 8;
+  HTTPSERecentlyUsedCache<std::string> single(1000, 1);
+  HTTPSERecentlyUsedCache<std::string> sharded(1000, 16);
+
+  RunParallelLookups(&single, kThreadCount);
+  RunParallelLookups(&sharded, kThreadCount);
+
+  for (int i = 0; i < 500; ++i) {
+    const std::string key =
+        "http://host" + base::NumberToString(i) + ".example.com/";
+    std::string single_value;
+    std::string sharded_value;
+    ASSERT_TRUE(single.get(key, &single_value)) << key;
+    ASSERT_TRUE(sharded.get(key, &sharded_value)) << key;
+    EXPECT_EQ("https" + key.substr(4), single_value);
+    EXPECT_EQ(single_value, sharded_value);
+  }
+}
@@ -0,0 +1,52 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_redirect_counter.h"
+
+#include <algorithm>
+
+namespace brave_shields {
+
+HTTPSERedirectCounter::HTTPSERedirectCounter(size_t max_requests)
+    : max_requests_per_shard_(
+          std::max<size_t>((max_requests + kShardCount - 1) / kShardCount,
+                           1)) {}
+
+HTTPSERedirectCounter::~HTTPSERedirectCounter() {}
+
+unsigned int HTTPSERedirectCounter::Get(uint64_t request_identifier) {
+  Shard& shard = GetShard(request_identifier);
+  base::AutoLock lock(shard.lock);
+  auto it = shard.counts.find(request_identifier);
+  return it == shard.counts.end() ? 0 : it->second;
+}
+
+void HTTPSERedirectCounter::Increment(uint64_t request_identifier) {
+  Shard& shard = GetShard(request_identifier);
+  base::AutoLock lock(shard.lock);
+  auto it = shard.counts.find(request_identifier);
+  if (it != shard.counts.end()) {
+    it->second++;
+    return;
+  }
+  // Only reached if requests leak without being removed.
+  if (shard.counts.size() >= max_requests_per_shard_) {
+    shard.counts.erase(shard.counts.begin());
+  }
+  shard.counts.emplace(request_identifier, 1);
+}
+
+void HTTPSERedirectCounter::Remove(uint64_t request_identifier) {
+  Shard& shard = GetShard(request_identifier);
+  base::AutoLock lock(shard.lock);
+  shard.counts.erase(request_identifier);
+}
+
+HTTPSERedirectCounter::Shard& HTTPSERedirectCounter::GetShard(
+    uint64_t request_identifier) {
+  return shards_[request_identifier % kShardCount];
+}
+
+}  // namespace brave_shields
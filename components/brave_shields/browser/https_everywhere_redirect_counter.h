@@ -0,0 +1,52 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_REDIRECT_COUNTER_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_REDIRECT_COUNTER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <unordered_map>
+
+#include "base/macros.h"
+#include "base/synchronization/lock.h"
+
+namespace brave_shields {
+
+// Counts the HTTPSE upgrades applied to each in-flight request so that
+// redirect loops can be broken. Requests are spread over independently
+// locked shards by request identifier, so concurrent navigations neither
+// evict each other's counts nor serialize on a single lock. Counts should be
+// removed when their request is destroyed; each shard is additionally bounded
+// in case that never happens.
+class HTTPSERedirectCounter {
+ public:
+  explicit HTTPSERedirectCounter(size_t max_requests = 4096);
+  ~HTTPSERedirectCounter();
+
+  unsigned int Get(uint64_t request_identifier);
+  void Increment(uint64_t request_identifier);
+  void Remove(uint64_t request_identifier);
+
+ private:
+  static const size_t kShardCount = 16;
+
+  struct Shard {
+    base::Lock lock;
+    std::unordered_map<uint64_t, unsigned int> counts;
+  };
+
+  Shard& GetShard(uint64_t request_identifier);
+
+  const size_t max_requests_per_shard_;
+  Shard shards_[kShardCount];
+
+  DISALLOW_COPY_AND_ASSIGN(HTTPSERedirectCounter);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_REDIRECT_COUNTER_H_
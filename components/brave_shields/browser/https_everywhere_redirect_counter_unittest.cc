@@ -0,0 +1,49 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_redirect_counter.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_shields {
+
+TEST(HTTPSERedirectCounterTest, CountsPerRequest) {
+  HTTPSERedirectCounter counter;
+  EXPECT_EQ(0u, counter.Get(1));
+
+  counter.Increment(1);
+  counter.Increment(1);
+  counter.Increment(2);
+  EXPECT_EQ(2u, counter.Get(1));
+  EXPECT_EQ(1u, counter.Get(2));
+
+  counter.Remove(1);
+  EXPECT_EQ(0u, counter.Get(1));
+  EXPECT_EQ(1u, counter.Get(2));
+}
+
+// Concurrent navigations used to evict each other's counts since only one
+// request was tracked at a time.
+TEST(HTTPSERedirectCounterTest, ManyInFlightRequests) {
+  HTTPSERedirectCounter counter;
+  for (uint64_t request = 1; request <= 1000; ++request) {
+    counter.Increment(request);
+  }
+  for (uint64_t request = 1; request <= 1000; ++request) {
+    counter.Increment(request);
+    EXPECT_EQ(2u, counter.Get(request));
+  }
+}
+
+TEST(HTTPSERedirectCounterTest, Bounded) {
+  HTTPSERedirectCounter counter(16);
+  // All of these land in the same shard, which holds a single request.
+  counter.Increment(16);
+  counter.Increment(32);
+  EXPECT_EQ(0u, counter.Get(16));
+  EXPECT_EQ(1u, counter.Get(32));
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,156 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_rule_set.h"
+
+#include <atomic>
+#include <utility>
+
+#include "base/json/json_reader.h"
+#include "base/values.h"
+#include "third_party/re2/src/re2/re2.h"
+#include "third_party/re2/src/re2/set.h"
+
+namespace brave_shields {
+
+namespace {
+
+// Rule sets are compiled on the HTTPSE task runner but tests read the count
+// from the UI thread.
+std::atomic<size_t> g_compile_count(0);
+
+}  // namespace
+
+std::string CorrecttoRuleToRE2Engine(const std::string& to) {
+  std::string correctedto(to);
+  size_t pos = to.find("$");
+  while (std::string::npos != pos) {
+    correctedto[pos] = '\\';
+    pos = correctedto.find("$");
+  }
+
+  return correctedto;
+}
+
+struct HTTPSERuleSet::Rule {
+  // Default rules upgrade the scheme without touching the rest of the URL.
+  bool is_default = false;
+  std::unique_ptr<re2::RE2> from;
+  std::string to;
+};
+
+struct HTTPSERuleSet::Target {
+  // Null if the target has no exclusions.
+  std::unique_ptr<re2::RE2::Set> exclusions;
+  // A target without a rule list stops the lookup for the whole rule set.
+  bool has_rules = false;
+  std::vector<Rule> rules;
+};
+
+HTTPSERuleSet::HTTPSERuleSet(base::StringPiece json) {
+  ++g_compile_count;
+  base::Optional<base::Value> json_object = base::JSONReader::Read(json);
+  if (!json_object || !json_object->is_list()) {
+    return;
+  }
+
+  for (const base::Value& target_value : json_object->GetList()) {
+    if (!target_value.is_dict()) {
+      continue;
+    }
+    auto target = std::make_unique<Target>();
+
+    const base::Value* exclusions = target_value.FindListKey("e");
+    if (exclusions) {
+      auto exclusion_set = std::make_unique<re2::RE2::Set>(
+          re2::RE2::DefaultOptions, re2::RE2::ANCHOR_BOTH);
+      bool has_exclusions = false;
+      for (const base::Value& exclusion : exclusions->GetList()) {
+        if (!exclusion.is_dict()) {
+          continue;
+        }
+        const std::string* pattern = exclusion.FindStringKey("p");
+        if (!pattern) {
+          continue;
+        }
+        // Patterns RE2 can't compile never matched before either.
+        if (exclusion_set->Add(CorrecttoRuleToRE2Engine(*pattern), nullptr) >=
+            0) {
+          has_exclusions = true;
+        }
+      }
+      if (has_exclusions && exclusion_set->Compile()) {
+        target->exclusions = std::move(exclusion_set);
+      }
+    }
+
+    const base::Value* rules = target_value.FindListKey("r");
+    if (rules) {
+      target->has_rules = true;
+      for (const base::Value& rule_value : rules->GetList()) {
+        if (!rule_value.is_dict()) {
+          continue;
+        }
+        Rule rule;
+        if (rule_value.FindKey("d")) {
+          rule.is_default = true;
+          target->rules.push_back(std::move(rule));
+          // Nothing after a default rule can ever be reached.
+          break;
+        }
+        const std::string* from = rule_value.FindStringKey("f");
+        const std::string* to = rule_value.FindStringKey("t");
+        if (!from || !to) {
+          continue;
+        }
+        rule.from = std::make_unique<re2::RE2>(*from);
+        if (!rule.from->ok()) {
+          continue;
+        }
+        rule.to = CorrecttoRuleToRE2Engine(*to);
+        target->rules.push_back(std::move(rule));
+      }
+    }
+
+    const bool has_rules = target->has_rules;
+    targets_.push_back(std::move(target));
+    // Nothing after a target without rules can ever be reached.
+    if (!has_rules) {
+      break;
+    }
+  }
+}
+
+HTTPSERuleSet::~HTTPSERuleSet() {}
+
+// static
+size_t HTTPSERuleSet::GetCompileCountForTesting() {
+  return g_compile_count;
+}
+
+std::string HTTPSERuleSet::Apply(const std::string& url) const {
+  for (const auto& target : targets_) {
+    if (target->exclusions && target->exclusions->Match(url, nullptr)) {
+      return "";
+    }
+    if (!target->has_rules) {
+      return "";
+    }
+    for (const Rule& rule : target->rules) {
+      if (rule.is_default) {
+        std::string new_url(url);
+        return new_url.insert(4, "s");
+      }
+      std::string new_url(url);
+      if (re2::RE2::Replace(&new_url, *rule.from, rule.to) &&
+          new_url != url) {
+        return new_url;
+      }
+    }
+  }
+  return "";
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,56 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULE_SET_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULE_SET_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/strings/string_piece.h"
+
+namespace re2 {
+class RE2;
+}  // namespace re2
+
+namespace brave_shields {
+
+// HTTPS Everywhere stores `$1`-style backreferences in its rewrite targets,
+// RE2 expects `\1`.
+std::string CorrecttoRuleToRE2Engine(const std::string& to);
+
+// The HTTPS Everywhere rules stored under a single leveldb key, parsed from
+// JSON and compiled into RE2 programs once so that they can be applied to
+// any number of URLs.
+class HTTPSERuleSet {
+ public:
+  // Parses the JSON value stored in leveldb. Malformed entries are skipped
+  // the same way ApplyHTTPSRule used to skip them.
+  explicit HTTPSERuleSet(base::StringPiece json);
+  ~HTTPSERuleSet();
+
+  // Returns the rewritten HTTPS URL for |url|, or an empty string if no rule
+  // applies.
+  std::string Apply(const std::string& url) const;
+
+  // Number of rule sets parsed and compiled in this process so far.
+  static size_t GetCompileCountForTesting();
+
+ private:
+  struct Rule;
+  struct Target;
+
+  std::vector<std::unique_ptr<Target>> targets_;
+
+  DISALLOW_COPY_AND_ASSIGN(HTTPSERuleSet);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULE_SET_H_
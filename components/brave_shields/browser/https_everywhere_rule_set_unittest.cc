@@ -0,0 +1,86 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_rule_set.h"
+
+#include <string>
+#include <vector>
+
+#include "base/strings/stringprintf.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_shields {
+
+namespace {
+
+const char kRuleSet[] = R"([{
+    "e": [{"p": "^http://example\\.com/insecure/.*"}],
+    "r": [{"f": "^http://(www\\.)?example\\.com/", "t": "https://$1example.com/"}]
+  }, {
+    "r": [{"d": 1}]
+  }])";
+
+}  // namespace
+
+TEST(HTTPSERuleSetTest, AppliesRewriteRule) {
+  HTTPSERuleSet rule_set(kRuleSet);
+  EXPECT_EQ("https://www.example.com/index.html",
+            rule_set.Apply("http://www.example.com/index.html"));
+}
+
+TEST(HTTPSERuleSetTest, ExclusionStopsLookup) {
+  HTTPSERuleSet rule_set(kRuleSet);
+  EXPECT_EQ("", rule_set.Apply("http://example.com/insecure/page"));
+}
+
+TEST(HTTPSERuleSetTest, FallsBackToLaterTarget) {
+  HTTPSERuleSet rule_set(kRuleSet);
+  EXPECT_EQ("https://cdn.example.com/a.js",
+            rule_set.Apply("http://cdn.example.com/a.js"));
+}
+
+TEST(HTTPSERuleSetTest, TargetWithoutRulesStopsLookup) {
+  HTTPSERuleSet rule_set(R"([{"e": []}, {"r": [{"d": 1}]}])");
+  EXPECT_EQ("", rule_set.Apply("http://example.com/"));
+}
+
+TEST(HTTPSERuleSetTest, MalformedJSON) {
+  EXPECT_EQ("", HTTPSERuleSet("").Apply("http://example.com/"));
+  EXPECT_EQ("", HTTPSERuleSet("{").Apply("http://example.com/"));
+  EXPECT_EQ("", HTTPSERuleSet(R"({"r": []})").Apply("http://example.com/"));
+  EXPECT_EQ("", HTTPSERuleSet(R"([{"r": [{"f": "(", "t": "https://"}]}])")
+                    .Apply("http://example.com/"));
+}
+
+TEST(HTTPSERuleSetTest, CorrectsBackreferences) {
+  EXPECT_EQ("https://\\1example.com/\\2",
+            CorrecttoRuleToRE2Engine("https://$1example.com/$2"));
+}
+
+// Applying a compiled rule set must not parse or compile it again, and must
+// give the same results as compiling it for every URL, which is what
+// ApplyHTTPSRule used to do on every cache miss.
+TEST(HTTPSERuleSetTest, CompiledRuleSetIsReused) {
+  std::vector<std::string> urls;
+  for (int i = 0; i < 20; ++i) {
+    urls.push_back(base::StringPrintf("http://www.example.com/page%d", i));
+    urls.push_back(base::StringPrintf("http://example.com/insecure/%d", i));
+  }
+
+  const size_t compile_count = HTTPSERuleSet::GetCompileCountForTesting();
+  HTTPSERuleSet compiled(kRuleSet);
+  EXPECT_EQ(compile_count + 1, HTTPSERuleSet::GetCompileCountForTesting());
+
+  for (int i = 0; i < 10; ++i) {
+    for (const std::string& url : urls)
+      compiled.Apply(url);
+  }
+  EXPECT_EQ(compile_count + 1, HTTPSERuleSet::GetCompileCountForTesting());
+
+  for (const std::string& url : urls)
+    EXPECT_EQ(HTTPSERuleSet(kRuleSet).Apply(url), compiled.Apply(url)) << url;
+}
+
+}  // namespace brave_shields
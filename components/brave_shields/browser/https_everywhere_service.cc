@@ -12,66 +12,98 @@
 
 #include "base/base_paths.h"
 #include "base/bind.h"
-#include "base/json/json_reader.h"
+#include "base/command_line.h"
 #include "base/logging.h"
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
+#include "base/metrics/histogram_macros.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_piece.h"
+#include "base/strings/string_split.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/threading/scoped_blocking_call.h"
-#include "base/values.h"
+#include "brave/common/brave_switches.h"
+#include "brave/components/brave_shields/browser/https_everywhere_lookup_table.h"
+#include "brave/components/brave_shields/browser/https_everywhere_rule_set.h"
 #include "third_party/leveldatabase/src/include/leveldb/db.h"
-#include "third_party/re2/src/re2/re2.h"
 #include "third_party/zlib/google/zip.h"
 
 #define DAT_FILE "httpse.leveldb.zip"
 #define DAT_FILE_VERSION "6.0"
-#define HTTPSE_URLS_REDIRECTS_COUNT_QUEUE   1
+#define LOOKUP_TABLE_FILE "httpse.table"
 #define HTTPSE_URL_MAX_REDIRECTS_COUNT      5
+#define HTTPSE_RULE_SETS_CACHE_SIZE         1000
+#define HTTPSE_RECENTLY_USED_CACHE_SIZE     1000
+#define HTTPSE_RECENTLY_USED_CACHE_SHARDS   16
 
 namespace {
 
-std::vector<std::string> Split(const std::string& s, char delim) {
-  std::stringstream ss(s);
-  std::string item;
-  std::vector<std::string> result;
-  while (getline(ss, item, delim)) {
-    result.push_back(item);
+// Returns the keys rule sets for |host| may be stored under, most specific
+// first, e.g. "com.example.www" and then "com.example.*" for
+// "www.example.com". The top level domain alone is never looked up. The keys
+// are views into |buffer|, which holds all of them back to back, so no string
+// is built per key.
+std::vector<base::StringPiece> ExpandDomainForLookup(base::StringPiece host,
+                                                     std::string* buffer) {
+  std::vector<base::StringPiece> keys;
+  std::vector<base::StringPiece> labels = base::SplitStringPiece(
+      host, ".", base::KEEP_WHITESPACE, base::SPLIT_WANT_ALL);
+  // A trailing dot doesn't add an empty label.
+  if (!labels.empty() && labels.back().empty()) {
+    labels.pop_back();
   }
-  return result;
-}
-
-// returns parts in reverse order, makes list of lookup domains like com.foo.*
-std::vector<std::string> ExpandDomainForLookup(const std::string& domain) {
-  std::vector<std::string> resultDomains;
-  std::vector<std::string> domainParts = Split(domain, '.');
-  if (domainParts.empty()) {
-    return resultDomains;
+  if (labels.size() < 2) {
+    return keys;
   }
 
-  for (size_t i = 0; i < domainParts.size() - 1; i++) {
-    // i < size()-1 is correct: don't want 'com.*' added to resultDomains
-    std::string slice = "";
-    std::string dot = "";
-    for (int j = domainParts.size() - 1; j >= static_cast<int>(i); j--) {
-      slice += dot + domainParts[j];
-      dot = ".";
+  std::vector<size_t> key_ends;
+  buffer->clear();
+  buffer->reserve((labels.size() - 1) * (host.size() + 2));
+  for (size_t i = 0; i < labels.size() - 1; i++) {
+    // i < size()-1 is correct: don't want 'com.*' added to the keys
+    for (size_t j = labels.size() - 1; j > i; j--) {
+      labels[j].AppendToString(buffer);
+      buffer->push_back('.');
     }
+    labels[i].AppendToString(buffer);
     if (0 != i) {
       // We don't want * on the top URL
-      resultDomains.push_back(slice + ".*");
-    } else {
-      resultDomains.push_back(slice);
+      buffer->append(".*");
     }
+    key_ends.push_back(buffer->size());
   }
-  return resultDomains;
+
+  size_t key_start = 0;
+  for (size_t key_end : key_ends) {
+    keys.push_back(
+        base::StringPiece(buffer->data() + key_start, key_end - key_start));
+    key_start = key_end;
+  }
+  return keys;
 }
-std::string leveldbGet(leveldb::DB* db, const std::string &key) {
+
+size_t GetRecentlyUsedCacheSize() {
+  const base::CommandLine& command_line =
+      *base::CommandLine::ForCurrentProcess();
+  size_t size = 0;
+  if (command_line.HasSwitch(switches::kHTTPSERecentlyUsedCacheSize) &&
+      base::StringToSizeT(command_line.GetSwitchValueASCII(
+                              switches::kHTTPSERecentlyUsedCacheSize),
+                          &size) &&
+      size > 0) {
+    return size;
+  }
+  return HTTPSE_RECENTLY_USED_CACHE_SIZE;
+}
+
+std::string leveldbGet(leveldb::DB* db, base::StringPiece key) {
   if (!db) {
     return "";
   }
 
   std::string value;
-  leveldb::Status s = db->Get(leveldb::ReadOptions(), key, &value);
+  leveldb::Status s = db->Get(leveldb::ReadOptions(),
+                              leveldb::Slice(key.data(), key.size()), &value);
   return s.ok() ? value : "";
 }
 
@@ -97,15 +129,27 @@ std::string
 HTTPSEverywhereService::g_https_everywhere_component_base64_public_key_(
     kHTTPSEverywhereComponentBase64PublicKey);
 
+struct HTTPSEverywhereService::CachedRuleSet {
+  // |rule_sets_cache_| is keyed by views of this string.
+  std::string key;
+  std::unique_ptr<HTTPSERuleSet> rule_set;
+};
+
 HTTPSEverywhereService::HTTPSEverywhereService(
     BraveComponent::Delegate* delegate)
     : BaseBraveShieldsService(delegate),
+      recently_used_cache_(GetRecentlyUsedCacheSize(),
+                           HTTPSE_RECENTLY_USED_CACHE_SHARDS),
+      rule_sets_cache_(HTTPSE_RULE_SETS_CACHE_SIZE),
       level_db_(nullptr) {
   DETACH_FROM_SEQUENCE(sequence_checker_);
 }
 
 HTTPSEverywhereService::~HTTPSEverywhereService() {
   GetTaskRunner()->DeleteSoon(FROM_HERE, level_db_);
+  if (lookup_table_) {
+    GetTaskRunner()->DeleteSoon(FROM_HERE, std::move(lookup_table_));
+  }
 }
 
 bool HTTPSEverywhereService::Init() {
@@ -121,6 +165,15 @@ void HTTPSEverywhereService::InitDB(const base::FilePath& install_dir) {
       install_dir.AppendASCII(DAT_FILE_VERSION).AppendASCII(DAT_FILE);
   base::FilePath unzipped_level_db_path = zip_db_file_path.RemoveExtension();
   base::FilePath destination = zip_db_file_path.DirName();
+  base::FilePath lookup_table_path =
+      destination.AppendASCII(LOOKUP_TABLE_FILE);
+
+  // The lookup table is generated from the leveldb the first time a
+  // component version is loaded, so later startups can skip the unzip.
+  if (OpenLookupTable(lookup_table_path)) {
+    return;
+  }
+
   if (!zip::Unzip(zip_db_file_path, destination)) {
     LOG(ERROR) << "Failed to unzip database file "
                << zip_db_file_path.value().c_str();
@@ -141,6 +194,25 @@ void HTTPSEverywhereService::InitDB(const base::FilePath& install_dir) {
     CloseDatabase();
     return;
   }
+
+  // Keep using the leveldb if the table can't be generated.
+  if (!HTTPSELookupTable::WriteFromLevelDB(level_db_, lookup_table_path)) {
+    LOG(ERROR) << "Failed to write HTTPSE lookup table "
+               << lookup_table_path.value().c_str();
+    return;
+  }
+  OpenLookupTable(lookup_table_path);
+}
+
+bool HTTPSEverywhereService::OpenLookupTable(const base::FilePath& path) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  auto lookup_table = std::make_unique<HTTPSELookupTable>();
+  if (!lookup_table->Initialize(path)) {
+    return false;
+  }
+  CloseDatabase();
+  lookup_table_ = std::move(lookup_table);
+  return true;
 }
 
 void HTTPSEverywhereService::OnComponentReady(
@@ -163,7 +235,8 @@ bool HTTPSEverywhereService::GetHTTPSURL(
   if (!url->is_valid())
     return false;
 
-  if (!IsInitialized() || !level_db_ || url->scheme() == url::kHttpsScheme) {
+  if (!IsInitialized() || (!level_db_ && !lookup_table_) ||
+      url->scheme() == url::kHttpsScheme) {
     return false;
   }
   if (!ShouldHTTPSERedirect(request_identifier)) {
@@ -182,17 +255,15 @@ bool HTTPSEverywhereService::GetHTTPSURL(
     candidate_url = candidate_url.ReplaceComponents(replacements);
   }
 
-  const std::vector<std::string> domains =
-      ExpandDomainForLookup(candidate_url.host());
-  for (auto domain : domains) {
-    std::string value = leveldbGet(level_db_, domain);
-    if (!value.empty()) {
-      *new_url = ApplyHTTPSRule(candidate_url.spec(), value);
-      if (0 != new_url->length()) {
-        recently_used_cache_.add(candidate_url.spec(), *new_url);
-        AddHTTPSEUrlToRedirectList(request_identifier);
-        return true;
-      }
+  std::string keys_buffer;
+  const std::vector<base::StringPiece> domains =
+      ExpandDomainForLookup(candidate_url.host_piece(), &keys_buffer);
+  for (base::StringPiece domain : domains) {
+    *new_url = GetRuleSet(domain).Apply(candidate_url.spec());
+    if (0 != new_url->length()) {
+      recently_used_cache_.add(candidate_url.spec(), *new_url);
+      AddHTTPSEUrlToRedirectList(request_identifier);
+      return true;
     }
   }
   recently_used_cache_.remove(candidate_url.spec());
@@ -213,7 +284,11 @@ bool HTTPSEverywhereService::GetHTTPSURLFromCacheOnly(
     return false;
   }
 
-  if (recently_used_cache_.get(url->spec(), cached_url)) {
+  // This runs first for every request, so it's where the hit rate is
+  // recorded.
+  bool hit = recently_used_cache_.get(url->spec(), cached_url);
+  UMA_HISTOGRAM_BOOLEAN("Brave.HTTPSE.RecentlyUsedCacheHit", hit);
+  if (hit) {
     AddHTTPSEUrlToRedirectList(request_identifier);
     return true;
   }
@@ -222,160 +297,47 @@ bool HTTPSEverywhereService::GetHTTPSURLFromCacheOnly(
 
 bool HTTPSEverywhereService::ShouldHTTPSERedirect(
     const uint64_t& request_identifier) {
-  base::AutoLock auto_lock(httpse_get_urls_redirects_count_mutex_);
-  for (size_t i = 0; i < httpse_urls_redirects_count_.size(); i++) {
-    if (request_identifier ==
-        httpse_urls_redirects_count_[i].request_identifier_ &&
-        httpse_urls_redirects_count_[i].redirects_ >=
-        HTTPSE_URL_MAX_REDIRECTS_COUNT - 1) {
-      return false;
-    }
-  }
-
-  return true;
+  return redirect_counter_.Get(request_identifier) <
+         HTTPSE_URL_MAX_REDIRECTS_COUNT - 1;
 }
 
 void HTTPSEverywhereService::AddHTTPSEUrlToRedirectList(
     const uint64_t& request_identifier) {
   // Adding redirects count for the current request
-  base::AutoLock auto_lock(httpse_get_urls_redirects_count_mutex_);
-  bool hostFound = false;
-  for (size_t i = 0; i < httpse_urls_redirects_count_.size(); i++) {
-    if (request_identifier ==
-        httpse_urls_redirects_count_[i].request_identifier_) {
-      // Found the host, just increment the redirects_count
-      httpse_urls_redirects_count_[i].redirects_++;
-      hostFound = true;
-      break;
-    }
-  }
-  if (!hostFound) {
-      // The host is new, adding it to the redirects list
-      if (httpse_urls_redirects_count_.size() >=
-          HTTPSE_URLS_REDIRECTS_COUNT_QUEUE) {
-          // The queue is full, erase the first element
-          httpse_urls_redirects_count_.erase(
-              httpse_urls_redirects_count_.begin());
-      }
-      httpse_urls_redirects_count_.push_back(
-          HTTPSE_REDIRECTS_COUNT_ST(request_identifier, 1));
-  }
+  redirect_counter_.Increment(request_identifier);
 }
 
-std::string HTTPSEverywhereService::ApplyHTTPSRule(
-    const std::string& originalUrl,
-    const std::string& rule) {
-  base::Optional<base::Value> json_object = base::JSONReader::Read(rule);
-  if (base::nullopt == json_object || !json_object->is_list()) {
-    return "";
-  }
-
-  base::Value::ConstListView topValues = json_object->GetList();
-  for (auto it = topValues.cbegin(); it != topValues.cend(); ++it) {
-    if (!it->is_dict()) {
-      continue;
-    }
-    const base::DictionaryValue* childTopDictionary = nullptr;
-    it->GetAsDictionary(&childTopDictionary);
-    if (nullptr == childTopDictionary) {
-      continue;
-    }
-
-    const base::Value* exclusion = nullptr;
-    if (childTopDictionary->Get("e", &exclusion)) {
-      const base::ListValue* eValues = nullptr;
-      exclusion->GetAsList(&eValues);
-      if (nullptr != eValues) {
-        for (size_t j = 0; j < eValues->GetSize(); ++j) {
-          const base::Value* pValue = nullptr;
-          if (!eValues->Get(j, &pValue)) {
-            continue;
-          }
-          const base::DictionaryValue* pDictionary = nullptr;
-          pValue->GetAsDictionary(&pDictionary);
-          if (nullptr == pDictionary) {
-            continue;
-          }
-          const base::Value* patternValue = nullptr;
-          if (!pDictionary->Get("p", &patternValue)) {
-            continue;
-          }
-          std::string pattern;
-          if (!patternValue->GetAsString(&pattern)) {
-            continue;
-          }
-          pattern = CorrecttoRuleToRE2Engine(pattern);
-          if (RE2::FullMatch(originalUrl, pattern)) {
-            return "";
-          }
-        }
-      }
-    }
-
-    const base::Value* rules = nullptr;
-    if (!childTopDictionary->Get("r", &rules)) {
-      return "";
-    }
-    const base::ListValue* rValues = nullptr;
-    rules->GetAsList(&rValues);
-    if (nullptr == rValues) {
-      return "";
-    }
-
-    for (size_t j = 0; j < rValues->GetSize(); ++j) {
-      const base::Value* pValue = nullptr;
-      if (!rValues->Get(j, &pValue)) {
-        continue;
-      }
-      const base::DictionaryValue* pDictionary = nullptr;
-      pValue->GetAsDictionary(&pDictionary);
-      if (nullptr == pDictionary) {
-        continue;
-      }
-      const base::Value* patternValue = nullptr;
-      if (pDictionary->Get("d", &patternValue)) {
-        std::string newUrl(originalUrl);
-        return newUrl.insert(4, "s");
-      }
-
-      const base::Value* from_value = nullptr;
-      const base::Value* to_value = nullptr;
-      if (!pDictionary->Get("f", &from_value) ||
-          !pDictionary->Get("t", &to_value)) {
-        continue;
-      }
-      std::string from, to;
-      if (!from_value->GetAsString(&from) ||
-          !to_value->GetAsString(&to)) {
-        continue;
-      }
-
-      to = CorrecttoRuleToRE2Engine(to);
-      std::string newUrl(originalUrl);
-      RE2 regExp(from);
-
-      if (RE2::Replace(&newUrl, regExp, to) && newUrl != originalUrl) {
-        return newUrl;
-      }
-    }
-  }
-  return "";
+void HTTPSEverywhereService::OnURLRequestDestroyed(
+    uint64_t request_identifier) {
+  redirect_counter_.Remove(request_identifier);
 }
 
-std::string HTTPSEverywhereService::CorrecttoRuleToRE2Engine(
-    const std::string& to) {
-  std::string correctedto(to);
-  size_t pos = to.find("$");
-  while (std::string::npos != pos) {
-    correctedto[pos] = '\\';
-    pos = correctedto.find("$");
+const HTTPSERuleSet& HTTPSEverywhereService::GetRuleSet(
+    base::StringPiece key) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  auto it = rule_sets_cache_.Get(key);
+  if (it == rule_sets_cache_.end()) {
+    // Keys without rules are cached too, so misses don't hit the database
+    // again.
+    auto cached = std::make_unique<CachedRuleSet>();
+    cached->key = key.as_string();
+    if (lookup_table_) {
+      cached->rule_set =
+          std::make_unique<HTTPSERuleSet>(lookup_table_->Find(key));
+    } else {
+      cached->rule_set =
+          std::make_unique<HTTPSERuleSet>(leveldbGet(level_db_, key));
+    }
+    const base::StringPiece cache_key(cached->key);
+    it = rule_sets_cache_.Put(cache_key, std::move(cached));
   }
-
-  return correctedto;
+  return *it->second->rule_set;
 }
 
 void HTTPSEverywhereService::CloseDatabase() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  rule_sets_cache_.Clear();
+  lookup_table_.reset();
   if (level_db_) {
     delete level_db_;
     level_db_ = nullptr;
@@ -8,14 +8,15 @@
 
 #include <memory>
 #include <string>
-#include <vector>
 
+#include "base/containers/mru_cache.h"
 #include "base/files/file_path.h"
 #include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
-#include "base/synchronization/lock.h"
+#include "base/strings/string_piece.h"
 #include "brave/components/brave_shields/browser/base_brave_shields_service.h"
 #include "brave/components/brave_shields/browser/https_everywhere_recently_used_cache.h"
+#include "brave/components/brave_shields/browser/https_everywhere_redirect_counter.h"
 
 namespace leveldb {
 class DB;
@@ -27,22 +28,13 @@ using brave_component_updater::BraveComponent;
 
 namespace brave_shields {
 
+class HTTPSELookupTable;
+class HTTPSERuleSet;
+
 extern const char kHTTPSEverywhereComponentName[];
 extern const char kHTTPSEverywhereComponentId[];
 extern const char kHTTPSEverywhereComponentBase64PublicKey[];
 
-struct HTTPSE_REDIRECTS_COUNT_ST {
- public:
-  HTTPSE_REDIRECTS_COUNT_ST(uint64_t request_identifier,
-                            unsigned int redirects):
-    request_identifier_(request_identifier),
-    redirects_(redirects) {
-  }
-
-  uint64_t request_identifier_;
-  unsigned int redirects_;
-};
-
 class HTTPSEverywhereService : public BaseBraveShieldsService,
                          public base::SupportsWeakPtr<HTTPSEverywhereService> {
  public:
@@ -54,6 +46,8 @@ class HTTPSEverywhereService : public BaseBraveShieldsService,
   bool GetHTTPSURLFromCacheOnly(const GURL* url,
                                 const uint64_t& request_id,
                                 std::string* cached_url);
+  // Forgets the redirect count of a request that has finished.
+  void OnURLRequestDestroyed(uint64_t request_identifier);
 
  protected:
   bool Init() override;
@@ -63,9 +57,8 @@ class HTTPSEverywhereService : public BaseBraveShieldsService,
 
   void AddHTTPSEUrlToRedirectList(const uint64_t& request_id);
   bool ShouldHTTPSERedirect(const uint64_t& request_id);
-  std::string ApplyHTTPSRule(const std::string& originalUrl,
-      const std::string& rule);
-  std::string CorrecttoRuleToRE2Engine(const std::string& to);
+  // Returns the compiled rules stored in leveldb under |key|.
+  const HTTPSERuleSet& GetRuleSet(base::StringPiece key);
 
  private:
   friend class ::HTTPSEverywhereServiceTest;
@@ -80,10 +73,16 @@ class HTTPSEverywhereService : public BaseBraveShieldsService,
   void CloseDatabase();
 
   void InitDB(const base::FilePath& install_dir);
+  bool OpenLookupTable(const base::FilePath& path);
 
-  base::Lock httpse_get_urls_redirects_count_mutex_;
-  std::vector<HTTPSE_REDIRECTS_COUNT_ST> httpse_urls_redirects_count_;
+  HTTPSERedirectCounter redirect_counter_;
   HTTPSERecentlyUsedCache<std::string> recently_used_cache_;
+  struct CachedRuleSet;
+  // Keyed by views of CachedRuleSet::key, so lookups don't copy the key.
+  base::MRUCache<base::StringPiece, std::unique_ptr<CachedRuleSet>>
+      rule_sets_cache_;
+  // Only one of |lookup_table_| and |level_db_| is open at a time.
+  std::unique_ptr<HTTPSELookupTable> lookup_table_;
   leveldb::DB* level_db_;
 
   SEQUENCE_CHECKER(sequence_checker_);
@@ -8,6 +8,7 @@
 #include "base/test/thread_test_helper.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/common/brave_paths.h"
+#include "brave/components/brave_shields/browser/https_everywhere_rule_set.h"
 #include "brave/components/brave_shields/browser/https_everywhere_service.h"
 #include "chrome/browser/extensions/extension_browsertest.h"
 #include "chrome/browser/ui/browser.h"
@@ -107,6 +108,29 @@ IN_PROC_BROWSER_TEST_F(HTTPSEverywhereServiceTest, RedirectsKnownSite) {
   EXPECT_EQ(GURL("https://www.digg.com/"), contents->GetLastCommittedURL());
 }
 
+// Load another URL on a site whose rules were already looked up and verify
+// the compiled rules were reused rather than compiled again.
+IN_PROC_BROWSER_TEST_F(HTTPSEverywhereServiceTest, ReusesCompiledRules) {
+  ASSERT_TRUE(InstallHTTPSEverywhereExtension());
+
+  ui_test_utils::NavigateToURL(
+      browser(), embedded_test_server()->GetURL("www.digg.com", "/"));
+  WaitForHTTPSEverywhereServiceThread();
+  const size_t compile_count =
+      brave_shields::HTTPSERuleSet::GetCompileCountForTesting();
+  EXPECT_LT(0u, compile_count);
+
+  ui_test_utils::NavigateToURL(
+      browser(), embedded_test_server()->GetURL("www.digg.com", "/other"));
+  WaitForHTTPSEverywhereServiceThread();
+  content::WebContents* contents =
+      browser()->tab_strip_model()->GetActiveWebContents();
+  EXPECT_EQ(GURL("https://www.digg.com/other"),
+            contents->GetLastCommittedURL());
+  EXPECT_EQ(compile_count,
+            brave_shields::HTTPSERuleSet::GetCompileCountForTesting());
+}
+
 // Load a URL which has no HTTPSE rule and verify we did not rewrite it.
 IN_PROC_BROWSER_TEST_F(HTTPSEverywhereServiceTest, NoRedirectsNotKnownSite) {
   ASSERT_TRUE(InstallHTTPSEverywhereExtension());
@@ -0,0 +1,134 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/query_string_filter.h"
+
+#include <algorithm>
+
+#include "base/json/json_reader.h"
+#include "base/logging.h"
+#include "base/no_destructor.h"
+#include "base/strings/string_util.h"
+#include "base/values.h"
+
+namespace brave_shields {
+
+namespace {
+
+// Case-insensitive FNV-1a.
+uint32_t HashKey(base::StringPiece key) {
+  uint32_t hash = 2166136261u;
+  for (char c : key) {
+    hash ^= static_cast<uint8_t>(base::ToLowerASCII(c));
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+}  // namespace
+
+// static
+scoped_refptr<const QueryStringTrackers> QueryStringTrackers::GetDefault() {
+  static const base::NoDestructor<scoped_refptr<const QueryStringTrackers>>
+      trackers(base::MakeRefCounted<QueryStringTrackers>(
+          std::vector<std::string>(
+              {// https://github.com/brave/brave-browser/issues/4239
+               "fbclid", "gclid", "msclkid", "mc_eid",
+               // https://github.com/brave/brave-browser/issues/9879
+               "dclid",
+               // https://github.com/brave/brave-browser/issues/9019
+               "_hsenc", "__hssc", "__hstc", "__hsfp", "hsCtaTracking"})));
+  return *trackers;
+}
+
+// static
+scoped_refptr<const QueryStringTrackers> QueryStringTrackers::FromJSON(
+    base::StringPiece json) {
+  base::Optional<base::Value> value = base::JSONReader::Read(json);
+  if (!value || !value->is_list() || value->GetList().empty())
+    return nullptr;
+
+  std::vector<std::string> keys;
+  for (const base::Value& key : value->GetList()) {
+    if (!key.is_string() || key.GetString().empty())
+      return nullptr;
+    keys.push_back(key.GetString());
+  }
+  return base::MakeRefCounted<QueryStringTrackers>(keys);
+}
+
+QueryStringTrackers::QueryStringTrackers(const std::vector<std::string>& keys) {
+  for (const std::string& key : keys)
+    keys_.push_back(base::ToLowerASCII(key));
+  std::sort(keys_.begin(), keys_.end());
+  keys_.erase(std::unique(keys_.begin(), keys_.end()), keys_.end());
+
+  // Keep the table at most half full so probe sequences stay short.
+  size_t slot_count = 4;
+  while (slot_count < keys_.size() * 2)
+    slot_count *= 2;
+  slots_.resize(slot_count, 0);
+  for (size_t i = 0; i < keys_.size(); ++i) {
+    size_t slot = HashKey(keys_[i]) & (slot_count - 1);
+    while (slots_[slot])
+      slot = (slot + 1) & (slot_count - 1);
+    slots_[slot] = static_cast<uint32_t>(i + 1);
+  }
+}
+
+QueryStringTrackers::~QueryStringTrackers() {}
+
+bool QueryStringTrackers::Contains(base::StringPiece key) const {
+  const size_t mask = slots_.size() - 1;
+  for (size_t slot = HashKey(key) & mask; slots_[slot];
+       slot = (slot + 1) & mask) {
+    if (base::EqualsCaseInsensitiveASCII(keys_[slots_[slot] - 1], key))
+      return true;
+  }
+  return false;
+}
+
+bool FilterQueryStringTrackers(base::StringPiece query,
+                               const QueryStringTrackers& trackers,
+                               std::string* filtered_query) {
+  DCHECK(filtered_query);
+  bool found_tracker = false;
+  // Whether a parameter has been kept, i.e. the next kept parameter needs to
+  // be preceded by a '&'.
+  bool has_kept = false;
+  size_t begin = 0;
+  while (begin <= query.size()) {
+    size_t end = query.find('&', begin);
+    if (end == base::StringPiece::npos)
+      end = query.size();
+    base::StringPiece parameter = query.substr(begin, end - begin);
+
+    size_t equals = parameter.find('=');
+    bool is_tracker = equals != base::StringPiece::npos &&
+                      equals + 1 < parameter.size() &&
+                      trackers.Contains(parameter.substr(0, equals));
+    if (is_tracker) {
+      if (!found_tracker) {
+        // Everything before the first tracker is kept as is.
+        found_tracker = true;
+        filtered_query->clear();
+        filtered_query->reserve(query.size());
+        if (begin > 0) {
+          filtered_query->assign(query.data(), begin - 1);
+          has_kept = true;
+        }
+      }
+    } else if (found_tracker) {
+      if (has_kept)
+        filtered_query->push_back('&');
+      filtered_query->append(parameter.data(), parameter.size());
+      has_kept = true;
+    }
+    begin = end + 1;
+  }
+  return found_tracker;
+}
+
+}  // namespace brave_shields
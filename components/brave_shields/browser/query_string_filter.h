@@ -0,0 +1,62 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_QUERY_STRING_FILTER_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_QUERY_STRING_FILTER_H_
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/strings/string_piece.h"
+
+namespace brave_shields {
+
+// An immutable, case-insensitive set of query string keys that identify
+// trackers, e.g. "fbclid". Keys are hashed in place, so lookups don't
+// allocate.
+class QueryStringTrackers
+    : public base::RefCountedThreadSafe<QueryStringTrackers> {
+ public:
+  // The trackers built into the browser, used until the local data files
+  // component provides its own list.
+  static scoped_refptr<const QueryStringTrackers> GetDefault();
+
+  // Parses a JSON list of keys. Returns nullptr if |json| isn't a non-empty
+  // list of strings.
+  static scoped_refptr<const QueryStringTrackers> FromJSON(
+      base::StringPiece json);
+
+  explicit QueryStringTrackers(const std::vector<std::string>& keys);
+
+  bool Contains(base::StringPiece key) const;
+  size_t size() const { return keys_.size(); }
+
+ private:
+  friend class base::RefCountedThreadSafe<QueryStringTrackers>;
+  ~QueryStringTrackers();
+
+  // Lower case and without duplicates.
+  std::vector<std::string> keys_;
+  // Open addressing table with a power of two size. Each slot holds an index
+  // into |keys_| plus one, or 0 if it's empty.
+  std::vector<uint32_t> slots_;
+
+  DISALLOW_COPY_AND_ASSIGN(QueryStringTrackers);
+};
+
+// Removes every "key=value" parameter of |query| whose key is in |trackers|
+// and whose value isn't empty, in a single pass over |query|. Returns false
+// without touching |filtered_query| if there is nothing to remove.
+bool FilterQueryStringTrackers(base::StringPiece query,
+                               const QueryStringTrackers& trackers,
+                               std::string* filtered_query);
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_QUERY_STRING_FILTER_H_
@@ -0,0 +1,92 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/query_string_filter_service.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/logging.h"
+#include "base/task_runner_util.h"
+#include "brave/components/brave_component_updater/browser/dat_file_util.h"
+#include "brave/components/brave_component_updater/browser/local_data_files_service.h"
+
+namespace brave_shields {
+
+namespace {
+
+const char kQueryFilterFileVersion[] = "1";
+const char kQueryFilterFile[] = "QueryFilter.json";
+
+scoped_refptr<const QueryStringTrackers> LoadTrackers(
+    const base::FilePath& path) {
+  // Component versions from before the list was moved out of the browser
+  // don't ship it, so the built-in list stays in use.
+  if (!base::PathExists(path)) {
+    VLOG(1) << "No query string trackers data in the component";
+    return nullptr;
+  }
+  std::string contents = brave_component_updater::GetDATFileAsString(path);
+  if (contents.empty()) {
+    LOG(ERROR) << "Could not obtain query string trackers data";
+    return nullptr;
+  }
+  scoped_refptr<const QueryStringTrackers> trackers =
+      QueryStringTrackers::FromJSON(contents);
+  if (!trackers)
+    LOG(ERROR) << "Failed to parse query string trackers data";
+  return trackers;
+}
+
+}  // namespace
+
+QueryStringFilterService::QueryStringFilterService(
+    LocalDataFilesService* local_data_files_service)
+    : LocalDataFilesObserver(local_data_files_service),
+      trackers_(QueryStringTrackers::GetDefault()) {}
+
+QueryStringFilterService::~QueryStringFilterService() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+}
+
+scoped_refptr<const QueryStringTrackers> QueryStringFilterService::trackers()
+    const {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  return trackers_;
+}
+
+void QueryStringFilterService::OnComponentReady(
+    const std::string& component_id,
+    const base::FilePath& install_dir,
+    const std::string& manifest) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  base::FilePath path = install_dir.AppendASCII(kQueryFilterFileVersion)
+                            .AppendASCII(kQueryFilterFile);
+
+  base::PostTaskAndReplyWithResult(
+      local_data_files_service()->GetTaskRunner().get(), FROM_HERE,
+      base::BindOnce(&LoadTrackers, path),
+      base::BindOnce(&QueryStringFilterService::OnTrackersLoaded,
+                     weak_factory_.GetWeakPtr()));
+}
+
+void QueryStringFilterService::OnTrackersLoaded(
+    scoped_refptr<const QueryStringTrackers> trackers) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  // Keep the current list if the component doesn't ship one.
+  if (trackers)
+    trackers_ = std::move(trackers);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+std::unique_ptr<QueryStringFilterService> QueryStringFilterServiceFactory(
+    LocalDataFilesService* local_data_files_service) {
+  return std::make_unique<QueryStringFilterService>(local_data_files_service);
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,54 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_QUERY_STRING_FILTER_SERVICE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_QUERY_STRING_FILTER_SERVICE_H_
+
+#include <memory>
+#include <string>
+
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
+#include "base/sequence_checker.h"
+#include "brave/components/brave_component_updater/browser/local_data_files_observer.h"
+#include "brave/components/brave_shields/browser/query_string_filter.h"
+
+using brave_component_updater::LocalDataFilesObserver;
+using brave_component_updater::LocalDataFilesService;
+
+namespace brave_shields {
+
+// Keeps the list of query string trackers up to date from the local data
+// files component. The built-in list is used until the component is ready.
+class QueryStringFilterService : public LocalDataFilesObserver {
+ public:
+  explicit QueryStringFilterService(
+      LocalDataFilesService* local_data_files_service);
+  ~QueryStringFilterService() override;
+
+  scoped_refptr<const QueryStringTrackers> trackers() const;
+
+  // implementation of LocalDataFilesObserver
+  void OnComponentReady(const std::string& component_id,
+                        const base::FilePath& install_dir,
+                        const std::string& manifest) override;
+
+ private:
+  void OnTrackersLoaded(scoped_refptr<const QueryStringTrackers> trackers);
+
+  SEQUENCE_CHECKER(sequence_checker_);
+  scoped_refptr<const QueryStringTrackers> trackers_;
+  base::WeakPtrFactory<QueryStringFilterService> weak_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(QueryStringFilterService);
+};
+
+// Creates the QueryStringFilterService
+std::unique_ptr<QueryStringFilterService> QueryStringFilterServiceFactory(
+    LocalDataFilesService* local_data_files_service);
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_QUERY_STRING_FILTER_SERVICE_H_
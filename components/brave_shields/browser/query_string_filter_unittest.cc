@@ -0,0 +1,145 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/query_string_filter.h"
+
+#include <string>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/re2/src/re2/re2.h"
+
+namespace brave_shields {
+
+namespace {
+
+const char kTrackers[] =
+    "fbclid|gclid|msclkid|mc_eid|dclid|_hsenc|__hssc|__hstc|__hsfp|"
+    "hsCtaTracking";
+
+// The three passes used before FilterQueryStringTrackers.
+class RegexQueryStringFilter {
+ public:
+  RegexQueryStringFilter()
+      : only_(std::string("^(") + kTrackers + ")=[^&]+$", Options()),
+        first_(std::string("^(") + kTrackers + ")=[^&]+&", Options()),
+        appended_(std::string("&(") + kTrackers + ")=[^&]+", Options()) {}
+
+  bool Filter(const std::string& query, std::string* filtered_query) const {
+    *filtered_query = query;
+    return re2::RE2::GlobalReplace(filtered_query, appended_, "") +
+               re2::RE2::GlobalReplace(filtered_query, first_, "") +
+               re2::RE2::GlobalReplace(filtered_query, only_, "") >
+           0;
+  }
+
+ private:
+  static re2::RE2::Options Options() {
+    re2::RE2::Options options;
+    options.set_case_sensitive(false);
+    return options;
+  }
+
+  re2::RE2 only_;
+  re2::RE2 first_;
+  re2::RE2 appended_;
+};
+
+std::string Filter(const std::string& query) {
+  std::string filtered_query;
+  if (!FilterQueryStringTrackers(query, *QueryStringTrackers::GetDefault(),
+                                 &filtered_query)) {
+    return query;
+  }
+  return filtered_query;
+}
+
+}  // namespace
+
+TEST(QueryStringTrackersTest, Contains) {
+  scoped_refptr<const QueryStringTrackers> trackers =
+      QueryStringTrackers::GetDefault();
+  EXPECT_EQ(10u, trackers->size());
+  EXPECT_TRUE(trackers->Contains("fbclid"));
+  EXPECT_TRUE(trackers->Contains("FBCLID"));
+  EXPECT_TRUE(trackers->Contains("hsctatracking"));
+  EXPECT_FALSE(trackers->Contains("fbclid2"));
+  EXPECT_FALSE(trackers->Contains("fbcli"));
+  EXPECT_FALSE(trackers->Contains(""));
+}
+
+TEST(QueryStringTrackersTest, FromJSON) {
+  scoped_refptr<const QueryStringTrackers> trackers =
+      QueryStringTrackers::FromJSON("[\"utm_source\", \"UTM_Source\", \"x\"]");
+  ASSERT_TRUE(trackers);
+  EXPECT_EQ(2u, trackers->size());
+  EXPECT_TRUE(trackers->Contains("utm_source"));
+  EXPECT_TRUE(trackers->Contains("X"));
+  EXPECT_FALSE(trackers->Contains("fbclid"));
+
+  EXPECT_FALSE(QueryStringTrackers::FromJSON("[]"));
+  EXPECT_FALSE(QueryStringTrackers::FromJSON("[\"\"]"));
+  EXPECT_FALSE(QueryStringTrackers::FromJSON("[1]"));
+  EXPECT_FALSE(QueryStringTrackers::FromJSON("{}"));
+  EXPECT_FALSE(QueryStringTrackers::FromJSON("not json"));
+}
+
+TEST(QueryStringFilterTest, Filter) {
+  EXPECT_EQ("", Filter("fbclid=1"));
+  EXPECT_EQ("a=1", Filter("fbclid=1&a=1"));
+  EXPECT_EQ("a=1", Filter("a=1&fbclid=1"));
+  EXPECT_EQ("a=1&b=2", Filter("a=1&fbclid=1&b=2"));
+  EXPECT_EQ("a=1", Filter("GCLID=1&a=1&__hsfp=2"));
+  EXPECT_EQ("", Filter("fbclid=1&gclid=2"));
+  // Empty values and keys that only share a prefix are kept.
+  EXPECT_EQ("fbclid=", Filter("fbclid="));
+  EXPECT_EQ("fbclid", Filter("fbclid"));
+  EXPECT_EQ("fbclid2=1", Filter("fbclid2=1"));
+  EXPECT_EQ("a=1&", Filter("a=1&&fbclid=1"));
+  EXPECT_EQ("&a=1", Filter("fbclid=1&&a=1"));
+  EXPECT_EQ("a=fbclid=1", Filter("a=fbclid=1"));
+
+  std::string filtered_query = "untouched";
+  EXPECT_FALSE(FilterQueryStringTrackers(
+      "a=1&b=2", *QueryStringTrackers::GetDefault(), &filtered_query));
+  EXPECT_EQ("untouched", filtered_query);
+}
+
+// Checks the single pass against the regexes it replaced and compares their
+// speed on a mix of clean and tracked query strings.
+TEST(QueryStringFilterTest, MatchesRegexFilter) {
+  const std::vector<std::string> keys = {"fbclid", "GCLID", "utm_source", "a",
+                                         "__hstc", "dclid2", "", "mc_eid"};
+  const std::vector<std::string> values = {"", "1", "x=y", "1234567890abc"};
+  std::vector<std::string> queries;
+  for (size_t i = 0; i < 5000; ++i) {
+    std::string query;
+    size_t parameter_count = i % 6;
+    for (size_t j = 0; j < parameter_count; ++j) {
+      const std::string& key = keys[(i * 7 + j * 3) % keys.size()];
+      const std::string& value = values[(i + j * 5) % values.size()];
+      if (j > 0)
+        query += (i + j) % 11 == 0 ? "&&" : "&";
+      query += (i + j) % 13 == 0 ? key : key + "=" + value;
+    }
+    queries.push_back(query);
+  }
+
+  const RegexQueryStringFilter regex_filter;
+  scoped_refptr<const QueryStringTrackers> trackers =
+      QueryStringTrackers::GetDefault();
+  for (const std::string& query : queries) {
+    std::string expected;
+    std::string filtered_query;
+    bool regex_changed = regex_filter.Filter(query, &expected);
+    EXPECT_EQ(regex_changed,
+              FilterQueryStringTrackers(query, *trackers, &filtered_query))
+        << query;
+    if (regex_changed)
+      EXPECT_EQ(expected, filtered_query) << query;
+  }
+}
+
+}  // namespace brave_shields
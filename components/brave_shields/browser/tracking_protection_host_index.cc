@@ -0,0 +1,65 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/tracking_protection_host_index.h"
+
+#include <algorithm>
+
+#include "base/logging.h"
+#include "base/strings/string_split.h"
+
+namespace brave_shields {
+
+// static
+scoped_refptr<TrackingProtectionHostIndex>
+TrackingProtectionHostIndex::FromDATContents(base::StringPiece contents) {
+  return base::MakeRefCounted<TrackingProtectionHostIndex>(
+      base::SplitStringPiece(contents, ",", base::TRIM_WHITESPACE,
+                             base::SPLIT_WANT_NONEMPTY));
+}
+
+TrackingProtectionHostIndex::TrackingProtectionHostIndex(
+    std::vector<base::StringPiece> hosts) {
+  std::sort(hosts.begin(), hosts.end());
+  hosts.erase(std::unique(hosts.begin(), hosts.end()), hosts.end());
+
+  size_t total_size = 0;
+  for (const auto& host : hosts)
+    total_size += host.size();
+  hosts_.reserve(total_size);
+  offsets_.reserve(hosts.size());
+  for (const auto& host : hosts) {
+    offsets_.push_back(static_cast<uint32_t>(hosts_.size()));
+    hosts_.append(host.data(), host.size());
+  }
+}
+
+TrackingProtectionHostIndex::~TrackingProtectionHostIndex() {}
+
+base::StringPiece TrackingProtectionHostIndex::HostAt(size_t index) const {
+  DCHECK_LT(index, offsets_.size());
+  size_t begin = offsets_[index];
+  size_t end =
+      index + 1 < offsets_.size() ? offsets_[index + 1] : hosts_.size();
+  return base::StringPiece(hosts_.data() + begin, end - begin);
+}
+
+bool TrackingProtectionHostIndex::Contains(base::StringPiece host) const {
+  size_t low = 0;
+  size_t high = offsets_.size();
+  while (low < high) {
+    size_t middle = low + (high - low) / 2;
+    int comparison = HostAt(middle).compare(host);
+    if (comparison == 0)
+      return true;
+    if (comparison < 0)
+      low = middle + 1;
+    else
+      high = middle;
+  }
+  return false;
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,57 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_TRACKING_PROTECTION_HOST_INDEX_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_TRACKING_PROTECTION_HOST_INDEX_H_
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/strings/string_piece.h"
+
+namespace brave_shields {
+
+// An immutable set of tracker hosts. All hosts are interned into a single
+// buffer and looked up by binary search over a sorted offset table, so a
+// lookup neither allocates nor copies the host being checked.
+//
+// An index is never modified after it is built. A new component version is
+// handled by building a new index off the UI thread and replacing the old
+// one, so readers never need a lock.
+class TrackingProtectionHostIndex
+    : public base::RefCountedThreadSafe<TrackingProtectionHostIndex> {
+ public:
+  // Builds an index from the comma separated host list shipped in the
+  // local data files component. Blocking, so don't call on the UI thread.
+  static scoped_refptr<TrackingProtectionHostIndex> FromDATContents(
+      base::StringPiece contents);
+
+  explicit TrackingProtectionHostIndex(std::vector<base::StringPiece> hosts);
+
+  bool Contains(base::StringPiece host) const;
+  size_t size() const { return offsets_.size(); }
+  bool empty() const { return offsets_.empty(); }
+
+ private:
+  friend class base::RefCountedThreadSafe<TrackingProtectionHostIndex>;
+  ~TrackingProtectionHostIndex();
+
+  base::StringPiece HostAt(size_t index) const;
+
+  // Every host, sorted and without duplicates, laid out back to back.
+  std::string hosts_;
+  // The start of each host in |hosts_|. Host i ends where host i + 1 starts.
+  std::vector<uint32_t> offsets_;
+
+  DISALLOW_COPY_AND_ASSIGN(TrackingProtectionHostIndex);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_TRACKING_PROTECTION_HOST_INDEX_H_
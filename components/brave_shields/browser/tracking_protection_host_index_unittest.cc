@@ -0,0 +1,63 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/tracking_protection_host_index.h"
+
+#include <string>
+#include <vector>
+
+#include "base/containers/flat_set.h"
+#include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_shields {
+
+TEST(TrackingProtectionHostIndexTest, ParsesDATContents) {
+  scoped_refptr<TrackingProtectionHostIndex> index =
+      TrackingProtectionHostIndex::FromDATContents(
+          " tracker.com,ads.example.com ,,tracker.com,a.b.c.net\n");
+  EXPECT_EQ(3u, index->size());
+  EXPECT_TRUE(index->Contains("tracker.com"));
+  EXPECT_TRUE(index->Contains("ads.example.com"));
+  EXPECT_TRUE(index->Contains("a.b.c.net"));
+  EXPECT_FALSE(index->Contains("example.com"));
+  EXPECT_FALSE(index->Contains("tracker.co"));
+  EXPECT_FALSE(index->Contains("tracker.comm"));
+  EXPECT_FALSE(index->Contains(""));
+}
+
+TEST(TrackingProtectionHostIndexTest, Empty) {
+  scoped_refptr<TrackingProtectionHostIndex> index =
+      TrackingProtectionHostIndex::FromDATContents(" , ");
+  EXPECT_TRUE(index->empty());
+  EXPECT_FALSE(index->Contains("tracker.com"));
+}
+
+// Checks lookups against the flat_set of strings the service used to keep.
+TEST(TrackingProtectionHostIndexTest, MatchesFlatSet) {
+  const int kHostCount = 20000;
+  std::vector<std::string> hosts;
+  for (int i = 0; i < kHostCount; ++i)
+    hosts.push_back(base::StringPrintf("tracker%d.example%d.com", i, i % 97));
+  const std::string contents = base::JoinString(hosts, ",");
+
+  base::flat_set<std::string> flat_set(base::SplitString(
+      contents, ",", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY));
+  scoped_refptr<TrackingProtectionHostIndex> index =
+      TrackingProtectionHostIndex::FromDATContents(contents);
+  ASSERT_EQ(flat_set.size(), index->size());
+
+  std::vector<std::string> queries;
+  for (int i = 0; i < kHostCount; i += 7) {
+    queries.push_back(hosts[i]);
+    queries.push_back(base::StringPrintf("site%d.example.com", i));
+  }
+  for (const std::string& query : queries)
+    EXPECT_EQ(flat_set.count(query) != 0, index->Contains(query)) << query;
+}
+
+}  // namespace brave_shields
@@ -17,7 +17,6 @@
 #include "content/public/browser/browser_thread.h"
 
 #if BUILDFLAG(BRAVE_STP_ENABLED)
-#include "base/strings/string_split.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
 #include "brave/components/brave_shields/browser/tracking_protection_helper.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
@@ -31,13 +30,33 @@ namespace brave_shields {
 #if BUILDFLAG(BRAVE_STP_ENABLED)
 const char kDatFileVersion[] = "1";
 const char kStorageTrackersFile[] = "StorageTrackingProtection.dat";
+
+namespace {
+
+scoped_refptr<const TrackingProtectionHostIndex> LoadStorageTrackersIndex(
+    const base::FilePath& path) {
+  std::string contents = brave_component_updater::GetDATFileAsString(path);
+  if (contents.empty()) {
+    LOG(ERROR) << "Could not obtain first party trackers data";
+    return nullptr;
+  }
+
+  scoped_refptr<const TrackingProtectionHostIndex> storage_trackers =
+      TrackingProtectionHostIndex::FromDATContents(contents);
+  if (storage_trackers->empty()) {
+    LOG(ERROR) << "No first party trackers found";
+    return nullptr;
+  }
+  return storage_trackers;
+}
+
+}  // namespace
 #endif
 
 TrackingProtectionService::TrackingProtectionService(
     LocalDataFilesService* local_data_files_service)
     : LocalDataFilesObserver(local_data_files_service),
-      weak_factory_(this),
-      weak_factory_io_thread_(this) {
+      weak_factory_(this) {
 }
 
 TrackingProtectionService::~TrackingProtectionService() {
@@ -128,7 +147,7 @@ bool TrackingProtectionService::ShouldStoreState(HostContentSettingsMap* map,
     return true;
   }
 
-  if (first_party_storage_trackers_.empty()) {
+  if (!first_party_storage_trackers_) {
     LOG(INFO) << "First party storage trackers list is empty";
     return true;
   }
@@ -152,36 +171,15 @@ bool TrackingProtectionService::ShouldStoreState(HostContentSettingsMap* map,
     return true;
 
   // deny storage if host is found in the tracker list
-  return first_party_storage_trackers_.find(host) ==
-         first_party_storage_trackers_.end();
+  return !first_party_storage_trackers_->Contains(host);
 }
 
-void TrackingProtectionService::OnGetSTPDATFileData(std::string contents) {
-  if (contents.empty()) {
-    LOG(ERROR) << "Could not obtain first party trackers data";
-    return;
-  }
-
-  std::vector<std::string> storage_trackers =
-      base::SplitString(base::StringPiece(contents.data(), contents.size()),
-                        ",", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
-
-  if (storage_trackers.empty()) {
-    LOG(ERROR) << "No first party trackers found";
+void TrackingProtectionService::OnStorageTrackersIndexLoaded(
+    scoped_refptr<const TrackingProtectionHostIndex> storage_trackers) {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  if (!storage_trackers)
     return;
-  }
-
-  base::PostTask(
-      FROM_HERE, {BrowserThread::IO},
-      base::BindOnce(
-          &TrackingProtectionService::UpdateFirstPartyStorageTrackers,
-          weak_factory_io_thread_.GetWeakPtr(), std::move(storage_trackers)));
-}
-
-void TrackingProtectionService::UpdateFirstPartyStorageTrackers(
-    std::vector<std::string> storage_trackers) {
-  first_party_storage_trackers_ =
-      base::flat_set<std::string>(std::move(storage_trackers));
+  first_party_storage_trackers_ = std::move(storage_trackers);
 }
 
 #else  // !BUILDFLAG(BRAVE_STP_ENABLED)
@@ -223,9 +221,9 @@ void TrackingProtectionService::OnComponentReady(
   base::PostTaskAndReplyWithResult(
       local_data_files_service()->GetTaskRunner().get(),
       FROM_HERE,
-      base::BindOnce(&brave_component_updater::GetDATFileAsString,
+      base::BindOnce(&LoadStorageTrackersIndex,
                      storage_tracking_protection_path),
-      base::BindOnce(&TrackingProtectionService::OnGetSTPDATFileData,
+      base::BindOnce(&TrackingProtectionService::OnStorageTrackersIndexLoaded,
                      weak_factory_.GetWeakPtr()));
 #endif
 }
@@ -12,14 +12,14 @@
 #include <utility>
 #include <vector>
 
-#include "base/containers/flat_set.h"
 #include "base/files/file_path.h"
+#include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
 #include "base/sequenced_task_runner.h"
-#include "base/synchronization/lock.h"
 #include "brave/components/brave_component_updater/browser/dat_file_util.h"
 #include "brave/components/brave_component_updater/browser/local_data_files_observer.h"
 #include "brave/components/brave_shields/browser/buildflags/buildflags.h"  // For STP
+#include "brave/components/brave_shields/browser/tracking_protection_host_index.h"
 #include "third_party/blink/public/mojom/loader/resource_load_info.mojom-shared.h"
 #include "url/gurl.h"
 
@@ -75,10 +75,10 @@ class TrackingProtectionService : public LocalDataFilesObserver {
 
  protected:
 #if BUILDFLAG(BRAVE_STP_ENABLED)
-  // ParseStorageTrackersData parses the storage trackers list provided by
-  // the offline-crawler
-  void OnGetSTPDATFileData(std::string contents);
-  void UpdateFirstPartyStorageTrackers(std::vector<std::string>);
+  // Replaces the storage trackers list provided by the offline-crawler with
+  // |storage_trackers|, which was built on the local data files task runner.
+  void OnStorageTrackersIndexLoaded(
+      scoped_refptr<const TrackingProtectionHostIndex> storage_trackers);
 
   // For Smart Tracking Protection, we need to keep track of the starting site
   // that initiated the redirects. We use RenderFrameIdKey to determine the
@@ -97,16 +97,14 @@ class TrackingProtectionService : public LocalDataFilesObserver {
 
  private:
 #if BUILDFLAG(BRAVE_STP_ENABLED)
-  base::flat_set<std::string> first_party_storage_trackers_;
+  // Only ever replaced as a whole on the UI thread, so ShouldStoreState can
+  // read it without a lock.
+  scoped_refptr<const TrackingProtectionHostIndex>
+      first_party_storage_trackers_;
   std::map<RenderFrameIdKey, GURL> render_frame_key_to_starting_site_url;
 #endif
 
-  std::vector<std::string> third_party_base_hosts_;
-  std::map<std::string, std::vector<std::string>> third_party_hosts_cache_;
-  base::Lock third_party_hosts_lock_;
-
   base::WeakPtrFactory<TrackingProtectionService> weak_factory_;
-  base::WeakPtrFactory<TrackingProtectionService> weak_factory_io_thread_;
   DISALLOW_COPY_AND_ASSIGN(TrackingProtectionService);
 };
 
@@ -15,6 +15,7 @@
 #include "brave/common/pref_names.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "brave/components/content_settings/core/browser/brave_content_settings_utils.h"
+#include "brave/components/content_settings/core/browser/brave_cookie_rules.h"
 #include "components/content_settings/core/browser/content_settings_pref.h"
 #include "components/content_settings/core/browser/website_settings_registry.h"
 #include "components/content_settings/core/common/content_settings_pattern.h"
@@ -58,29 +59,6 @@ Rule CloneRule(const Rule& rule, bool reverse_patterns = false) {
               rule.expiration, rule.session_model);
 }
 
-class BraveShieldsRuleIterator : public RuleIterator {
- public:
-  explicit BraveShieldsRuleIterator(std::vector<Rule> rules)
-      : rules_(std::move(rules)) {
-    iterator_ = rules_.begin();
-  }
-
-  bool HasNext() const override {
-    return iterator_ != rules_.end();
-  }
-
-  Rule Next() override {
-    return CloneRule(*(iterator_++));
-  }
-
- private:
-  std::vector<Rule> rules_;
-  std::vector<Rule>::const_iterator iterator_;
-
-  DISALLOW_COPY_AND_ASSIGN(BraveShieldsRuleIterator);
-};
-
-
 bool IsActive(const Rule& cookie_rule,
               const std::vector<Rule>& shield_rules) {
   // don't include default rules in the iterator
@@ -249,16 +227,11 @@ bool BravePrefProvider::SetWebsiteSetting(
 
   // handle changes to brave cookie settings from chromium cookie settings UI
   if (content_type == ContentSettingsType::COOKIES) {
-    auto* value = in_value.get();
-    auto match = std::find_if(
-        brave_cookie_rules_[off_the_record_].begin(),
-        brave_cookie_rules_[off_the_record_].end(),
-        [primary_pattern, secondary_pattern, value](const auto& rule) {
-          return rule.primary_pattern == primary_pattern &&
-                 rule.secondary_pattern == secondary_pattern &&
-                 ValueToContentSetting(&rule.value) !=
-                    ValueToContentSetting(value); });
-    if (match != brave_cookie_rules_[off_the_record_].end()) {
+    const auto& brave_cookie_rules = brave_cookie_rules_[off_the_record_];
+    if (brave_cookie_rules &&
+        brave_cookie_rules->HasRuleWithOtherSetting(
+            primary_pattern, secondary_pattern,
+            ValueToContentSetting(in_value.get()))) {
       // swap primary/secondary pattern - see CloneRule
       auto plugin_primary_pattern = secondary_pattern;
       auto plugin_secondary_pattern = primary_pattern;
@@ -287,14 +260,12 @@ std::unique_ptr<RuleIterator> BravePrefProvider::GetRuleIterator(
       const ResourceIdentifier& resource_identifier,
       bool incognito) const {
   if (content_type == ContentSettingsType::COOKIES) {
-    std::vector<Rule> rules;
-    for (auto i = cookie_rules_.at(incognito).begin();
-         i != cookie_rules_.at(incognito).end();
-         ++i) {
-      rules.emplace_back(CloneRule(*i));
+    scoped_refptr<const BraveCookieRules> rules;
+    {
+      base::AutoLock lock(cookie_rules_lock_);
+      rules = cookie_rules_.at(incognito);
     }
-
-    return std::make_unique<BraveShieldsRuleIterator>(std::move(rules));
+    return rules->CreateIterator();
   }
 
   // Early return. We don't store flash plugin setting in preference.
@@ -309,11 +280,8 @@ std::unique_ptr<RuleIterator> BravePrefProvider::GetRuleIterator(
 
 void BravePrefProvider::UpdateCookieRules(ContentSettingsType content_type,
                                           bool incognito) {
-  auto& rules = cookie_rules_[incognito];
-  auto old_rules = std::move(brave_cookie_rules_[incognito]);
-
-  rules.clear();
-  brave_cookie_rules_[incognito].clear();
+  std::vector<Rule> rules;
+  std::vector<Rule> brave_cookie_rules;
 
   // kGoogleLoginControlType preference adds an exception for
   // accounts.google.com to access cookies in 3p context to allow login using
@@ -333,7 +301,7 @@ void BravePrefProvider::UpdateCookieRules(ContentSettingsType content_type,
                          ContentSettingToValue(CONTENT_SETTING_ALLOW)),
                      base::Time(), SessionModel::Durable);
     rules.emplace_back(CloneRule(google_auth_rule));
-    brave_cookie_rules_[incognito].emplace_back(CloneRule(google_auth_rule));
+    brave_cookie_rules.emplace_back(CloneRule(google_auth_rule));
 
     const auto firebase_rule = Rule(
         ContentSettingsPattern::FromString(kFirebasePattern),
@@ -342,7 +310,7 @@ void BravePrefProvider::UpdateCookieRules(ContentSettingsType content_type,
             ContentSettingToValue(CONTENT_SETTING_ALLOW)),
         base::Time(), SessionModel::Durable);
     rules.emplace_back(CloneRule(firebase_rule));
-    brave_cookie_rules_[incognito].emplace_back(CloneRule(firebase_rule));
+    brave_cookie_rules.emplace_back(CloneRule(firebase_rule));
   }
   // non-pref based exceptions should go in the cookie_settings_base.cc
   // chromium_src override
@@ -381,7 +349,7 @@ void BravePrefProvider::UpdateCookieRules(ContentSettingsType content_type,
     auto rule = brave_cookies_iterator->Next();
     if (IsActive(rule, shield_rules)) {
       rules.emplace_back(CloneRule(rule, true));
-      brave_cookie_rules_[incognito].emplace_back(CloneRule(rule, true));
+      brave_cookie_rules.emplace_back(CloneRule(rule, true));
     }
   }
 
@@ -399,7 +367,7 @@ void BravePrefProvider::UpdateCookieRules(ContentSettingsType content_type,
                base::Value::FromUniquePtrValue(
                    ContentSettingToValue(CONTENT_SETTING_ALLOW)),
                base::Time(), SessionModel::Durable));
-      brave_cookie_rules_[incognito].emplace_back(
+      brave_cookie_rules.emplace_back(
           Rule(ContentSettingsPattern::Wildcard(),
                shield_rule.primary_pattern,
                base::Value::FromUniquePtrValue(
@@ -408,42 +376,19 @@ void BravePrefProvider::UpdateCookieRules(ContentSettingsType content_type,
     }
   }
 
-  // get the list of changes
-  std::vector<Rule> brave_cookie_updates;
-  for (const auto& new_rule : brave_cookie_rules_[incognito]) {
-    auto match = std::find_if(
-        old_rules.begin(),
-        old_rules.end(),
-        [&new_rule](const auto& old_rule) {
-          // we want an exact match here because any change to the rule
-          // is an update
-          return new_rule.primary_pattern == old_rule.primary_pattern &&
-                 new_rule.secondary_pattern == old_rule.secondary_pattern &&
-                 ValueToContentSetting(&new_rule.value) ==
-                    ValueToContentSetting(&old_rule.value);
-        });
-    if (match == old_rules.end()) {
-      brave_cookie_updates.emplace_back(CloneRule(new_rule));
-    }
+  {
+    base::AutoLock lock(cookie_rules_lock_);
+    cookie_rules_[incognito] =
+        base::MakeRefCounted<BraveCookieRules>(std::move(rules));
   }
+  scoped_refptr<const BraveCookieRules> old_rules =
+      std::move(brave_cookie_rules_[incognito]);
+  brave_cookie_rules_[incognito] =
+      base::MakeRefCounted<BraveCookieRules>(std::move(brave_cookie_rules));
 
-  // find any removed rules
-  for (const auto& old_rule : old_rules) {
-    auto match = std::find_if(
-        brave_cookie_rules_[incognito].begin(),
-        brave_cookie_rules_[incognito].end(),
-        [&old_rule](const auto& new_rule) {
-          // we only care about the patterns here because we're looking
-          // for deleted rules, not changed rules
-          return new_rule.primary_pattern == old_rule.primary_pattern &&
-                 new_rule.secondary_pattern == old_rule.secondary_pattern;
-        });
-    if (match == brave_cookie_rules_[incognito].end()) {
-      brave_cookie_updates.emplace_back(
-          Rule(old_rule.primary_pattern, old_rule.secondary_pattern,
-               base::Value(), old_rule.expiration, old_rule.session_model));
-    }
-  }
+  // get the list of changes
+  std::vector<Rule> brave_cookie_updates =
+      brave_cookie_rules_[incognito]->GetChangesSince(old_rules.get());
 
   // Notify brave cookie changes as ContentSettingsType::COOKIES
   if (initialized_ && content_type == ContentSettingsType::PLUGINS) {
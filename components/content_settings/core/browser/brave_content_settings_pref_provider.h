@@ -11,13 +11,17 @@
 #include <string>
 #include <vector>
 
+#include "base/memory/scoped_refptr.h"
 #include "base/memory/weak_ptr.h"
+#include "base/synchronization/lock.h"
 #include "components/content_settings/core/browser/content_settings_observer.h"
 #include "components/content_settings/core/browser/content_settings_pref_provider.h"
 #include "components/prefs/pref_change_registrar.h"
 
 namespace content_settings {
 
+class BraveCookieRules;
+
 // With this subclass, shields configuration is persisted across sessions.
 // Its content type is |ContentSettingsType::PLUGIN| and its storage option is
 // ephemeral because chromium want that flash configuration shouldn't be
@@ -72,8 +76,13 @@ class BravePrefProvider : public PrefProvider,
   // PrefProvider::pref_change_registrar_ alreay has plugin type.
   PrefChangeRegistrar brave_pref_change_registrar_;
 
-  std::map<bool /* is_incognito */, std::vector<Rule>> cookie_rules_;
-  std::map<bool /* is_incognito */, std::vector<Rule>> brave_cookie_rules_;
+  // GetRuleIterator() may be called on any thread, so |cookie_rules_| is
+  // swapped under |cookie_rules_lock_|.
+  mutable base::Lock cookie_rules_lock_;
+  std::map<bool /* is_incognito */, scoped_refptr<const BraveCookieRules>>
+      cookie_rules_;
+  std::map<bool /* is_incognito */, scoped_refptr<const BraveCookieRules>>
+      brave_cookie_rules_;
 
   bool initialized_;
 
@@ -0,0 +1,124 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/content_settings/core/browser/brave_cookie_rules.h"
+
+#include <utility>
+
+#include "components/content_settings/core/browser/content_settings_utils.h"
+
+namespace content_settings {
+
+namespace {
+
+// The lowest ContentSetting, used to find the first key for a pair of
+// patterns.
+const ContentSetting kLowestContentSetting = CONTENT_SETTING_DEFAULT;
+
+Rule CopyRule(const Rule& rule) {
+  return Rule(rule.primary_pattern, rule.secondary_pattern, rule.value.Clone(),
+              rule.expiration, rule.session_model);
+}
+
+class BraveCookieRuleIterator : public RuleIterator {
+ public:
+  explicit BraveCookieRuleIterator(scoped_refptr<const BraveCookieRules> rules)
+      : rules_(std::move(rules)) {}
+
+  bool HasNext() const override { return index_ < rules_->rules().size(); }
+
+  Rule Next() override { return CopyRule(rules_->rules()[index_++]); }
+
+ private:
+  scoped_refptr<const BraveCookieRules> rules_;
+  size_t index_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(BraveCookieRuleIterator);
+};
+
+}  // namespace
+
+BraveCookieRules::BraveCookieRules(std::vector<Rule> rules)
+    : rules_(std::move(rules)) {
+  std::vector<Key> keys;
+  keys.reserve(rules_.size());
+  for (const Rule& rule : rules_) {
+    keys.emplace_back(rule.primary_pattern, rule.secondary_pattern,
+                      ValueToContentSetting(&rule.value));
+  }
+  index_ = Index(std::move(keys));
+}
+
+BraveCookieRules::~BraveCookieRules() = default;
+
+bool BraveCookieRules::HasRule(
+    const ContentSettingsPattern& primary_pattern,
+    const ContentSettingsPattern& secondary_pattern) const {
+  auto it = FindFirst(primary_pattern, secondary_pattern);
+  return it != index_.end() && std::get<0>(*it) == primary_pattern &&
+         std::get<1>(*it) == secondary_pattern;
+}
+
+bool BraveCookieRules::HasRule(const ContentSettingsPattern& primary_pattern,
+                               const ContentSettingsPattern& secondary_pattern,
+                               ContentSetting setting) const {
+  return index_.find(std::tie(primary_pattern, secondary_pattern, setting)) !=
+         index_.end();
+}
+
+bool BraveCookieRules::HasRuleWithOtherSetting(
+    const ContentSettingsPattern& primary_pattern,
+    const ContentSettingsPattern& secondary_pattern,
+    ContentSetting setting) const {
+  for (auto it = FindFirst(primary_pattern, secondary_pattern);
+       it != index_.end() && std::get<0>(*it) == primary_pattern &&
+       std::get<1>(*it) == secondary_pattern;
+       ++it) {
+    if (std::get<2>(*it) != setting)
+      return true;
+  }
+  return false;
+}
+
+std::vector<Rule> BraveCookieRules::GetChangesSince(
+    const BraveCookieRules* old_rules) const {
+  std::vector<Rule> changes;
+  for (const Rule& rule : rules_) {
+    // we want an exact match here because any change to the rule is an update
+    if (!old_rules ||
+        !old_rules->HasRule(rule.primary_pattern, rule.secondary_pattern,
+                            ValueToContentSetting(&rule.value))) {
+      changes.push_back(CopyRule(rule));
+    }
+  }
+
+  if (!old_rules)
+    return changes;
+
+  // we only care about the patterns here because we're looking for deleted
+  // rules, not changed rules
+  for (const Rule& old_rule : old_rules->rules_) {
+    if (!HasRule(old_rule.primary_pattern, old_rule.secondary_pattern)) {
+      changes.emplace_back(old_rule.primary_pattern,
+                           old_rule.secondary_pattern, base::Value(),
+                           old_rule.expiration, old_rule.session_model);
+    }
+  }
+  return changes;
+}
+
+BraveCookieRules::Index::const_iterator BraveCookieRules::FindFirst(
+    const ContentSettingsPattern& primary_pattern,
+    const ContentSettingsPattern& secondary_pattern) const {
+  return index_.lower_bound(
+      std::tie(primary_pattern, secondary_pattern, kLowestContentSetting));
+}
+
+std::unique_ptr<RuleIterator> BraveCookieRules::CreateIterator() const {
+  return std::make_unique<BraveCookieRuleIterator>(
+      base::WrapRefCounted(this));
+}
+
+}  // namespace content_settings
@@ -0,0 +1,74 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_CONTENT_SETTINGS_CORE_BROWSER_BRAVE_COOKIE_RULES_H_
+#define BRAVE_COMPONENTS_CONTENT_SETTINGS_CORE_BROWSER_BRAVE_COOKIE_RULES_H_
+
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include "base/containers/flat_set.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "components/content_settings/core/browser/content_settings_rule.h"
+#include "components/content_settings/core/common/content_settings.h"
+#include "components/content_settings/core/common/content_settings_pattern.h"
+
+namespace content_settings {
+
+// An immutable list of cookie rules in precedence order, indexed by patterns
+// and setting. Rule iterators share the list instead of copying it, so it can
+// be handed out on any thread while a newer list replaces it.
+class BraveCookieRules : public base::RefCountedThreadSafe<BraveCookieRules> {
+ public:
+  explicit BraveCookieRules(std::vector<Rule> rules);
+
+  const std::vector<Rule>& rules() const { return rules_; }
+
+  // Returns true if there is a rule for the patterns.
+  bool HasRule(const ContentSettingsPattern& primary_pattern,
+               const ContentSettingsPattern& secondary_pattern) const;
+  // Returns true if there is a rule for the patterns with |setting|.
+  bool HasRule(const ContentSettingsPattern& primary_pattern,
+               const ContentSettingsPattern& secondary_pattern,
+               ContentSetting setting) const;
+  // Returns true if there is a rule for the patterns with a setting other
+  // than |setting|.
+  bool HasRuleWithOtherSetting(const ContentSettingsPattern& primary_pattern,
+                               const ContentSettingsPattern& secondary_pattern,
+                               ContentSetting setting) const;
+
+  // Returns the rules that were added or changed since |old_rules|, followed by
+  // a rule with an empty value for each pair of patterns that no longer has a
+  // rule. |old_rules| may be null if there were no rules before.
+  std::vector<Rule> GetChangesSince(const BraveCookieRules* old_rules) const;
+
+  std::unique_ptr<RuleIterator> CreateIterator() const;
+
+ private:
+  friend class base::RefCountedThreadSafe<BraveCookieRules>;
+  using Key =
+      std::tuple<ContentSettingsPattern, ContentSettingsPattern, ContentSetting>;
+  using Index = base::flat_set<Key, std::less<>>;
+
+  ~BraveCookieRules();
+
+  // Returns the first key for the patterns, if there is one, or else the key
+  // after where it would be.
+  Index::const_iterator FindFirst(
+      const ContentSettingsPattern& primary_pattern,
+      const ContentSettingsPattern& secondary_pattern) const;
+
+  const std::vector<Rule> rules_;
+  Index index_;
+
+  DISALLOW_COPY_AND_ASSIGN(BraveCookieRules);
+};
+
+}  // namespace content_settings
+
+#endif  // BRAVE_COMPONENTS_CONTENT_SETTINGS_CORE_BROWSER_BRAVE_COOKIE_RULES_H_
@@ -0,0 +1,164 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/content_settings/core/browser/brave_cookie_rules.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/strings/stringprintf.h"
+#include "components/content_settings/core/browser/content_settings_utils.h"
+#include "components/content_settings/core/common/content_settings_utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace content_settings {
+
+namespace {
+
+Rule MakeRule(const std::string& primary,
+              const std::string& secondary,
+              ContentSetting setting) {
+  return Rule(ContentSettingsPattern::FromString(primary),
+              ContentSettingsPattern::FromString(secondary),
+              base::Value::FromUniquePtrValue(ContentSettingToValue(setting)),
+              base::Time(), SessionModel::Durable);
+}
+
+Rule CopyRule(const Rule& rule) {
+  return Rule(rule.primary_pattern, rule.secondary_pattern, rule.value.Clone(),
+              rule.expiration, rule.session_model);
+}
+
+// Site exceptions like the ones BravePrefProvider builds from shields
+// settings. |changed| sites get the other setting.
+std::vector<Rule> MakeSiteRules(int site_count, int changed) {
+  std::vector<Rule> rules;
+  for (int i = 0; i < site_count; ++i) {
+    const std::string site = base::StringPrintf("*://[*.]site%d.com/*", i);
+    rules.push_back(
+        MakeRule("*", site,
+                 i < changed ? CONTENT_SETTING_BLOCK : CONTENT_SETTING_ALLOW));
+  }
+  return rules;
+}
+
+// How BravePrefProvider diffed cookie rules before BraveCookieRules.
+std::vector<Rule> GetChangesWithFindIf(const std::vector<Rule>& old_rules,
+                                       const std::vector<Rule>& new_rules) {
+  std::vector<Rule> changes;
+  for (const auto& new_rule : new_rules) {
+    auto match = std::find_if(
+        old_rules.begin(), old_rules.end(), [&new_rule](const auto& old_rule) {
+          return new_rule.primary_pattern == old_rule.primary_pattern &&
+                 new_rule.secondary_pattern == old_rule.secondary_pattern &&
+                 ValueToContentSetting(&new_rule.value) ==
+                     ValueToContentSetting(&old_rule.value);
+        });
+    if (match == old_rules.end())
+      changes.push_back(CopyRule(new_rule));
+  }
+  for (const auto& old_rule : old_rules) {
+    auto match = std::find_if(
+        new_rules.begin(), new_rules.end(), [&old_rule](const auto& new_rule) {
+          return new_rule.primary_pattern == old_rule.primary_pattern &&
+                 new_rule.secondary_pattern == old_rule.secondary_pattern;
+        });
+    if (match == new_rules.end()) {
+      changes.emplace_back(old_rule.primary_pattern,
+                           old_rule.secondary_pattern, base::Value(),
+                           old_rule.expiration, old_rule.session_model);
+    }
+  }
+  return changes;
+}
+
+std::vector<Rule> CopyRules(const std::vector<Rule>& rules) {
+  std::vector<Rule> copy;
+  for (const Rule& rule : rules)
+    copy.push_back(CopyRule(rule));
+  return copy;
+}
+
+void ExpectSameRules(const std::vector<Rule>& expected,
+                     const std::vector<Rule>& actual) {
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(expected[i].primary_pattern, actual[i].primary_pattern);
+    EXPECT_EQ(expected[i].secondary_pattern, actual[i].secondary_pattern);
+    EXPECT_EQ(expected[i].value, actual[i].value);
+  }
+}
+
+}  // namespace
+
+TEST(BraveCookieRulesTest, Lookups) {
+  std::vector<Rule> rules;
+  rules.push_back(MakeRule("https://a.com/*", "*", CONTENT_SETTING_ALLOW));
+  rules.push_back(MakeRule("*", "https://b.com/*", CONTENT_SETTING_BLOCK));
+  auto cookie_rules = base::MakeRefCounted<BraveCookieRules>(std::move(rules));
+
+  const auto a = ContentSettingsPattern::FromString("https://a.com/*");
+  const auto b = ContentSettingsPattern::FromString("https://b.com/*");
+  const auto wildcard = ContentSettingsPattern::Wildcard();
+  EXPECT_TRUE(cookie_rules->HasRule(a, wildcard));
+  EXPECT_FALSE(cookie_rules->HasRule(wildcard, a));
+  EXPECT_TRUE(cookie_rules->HasRule(wildcard, b, CONTENT_SETTING_BLOCK));
+  EXPECT_FALSE(cookie_rules->HasRule(wildcard, b, CONTENT_SETTING_ALLOW));
+  EXPECT_TRUE(
+      cookie_rules->HasRuleWithOtherSetting(a, wildcard, CONTENT_SETTING_BLOCK));
+  EXPECT_FALSE(
+      cookie_rules->HasRuleWithOtherSetting(a, wildcard, CONTENT_SETTING_ALLOW));
+  EXPECT_FALSE(
+      cookie_rules->HasRuleWithOtherSetting(b, b, CONTENT_SETTING_ALLOW));
+}
+
+TEST(BraveCookieRulesTest, IteratorOutlivesRules) {
+  std::unique_ptr<RuleIterator> iterator;
+  {
+    auto cookie_rules =
+        base::MakeRefCounted<BraveCookieRules>(MakeSiteRules(3, 1));
+    iterator = cookie_rules->CreateIterator();
+  }
+  std::vector<Rule> iterated;
+  while (iterator->HasNext())
+    iterated.push_back(iterator->Next());
+  ExpectSameRules(MakeSiteRules(3, 1), iterated);
+}
+
+TEST(BraveCookieRulesTest, ChangesSinceNothing) {
+  auto cookie_rules =
+      base::MakeRefCounted<BraveCookieRules>(MakeSiteRules(5, 2));
+  ExpectSameRules(MakeSiteRules(5, 2), cookie_rules->GetChangesSince(nullptr));
+}
+
+// Checks that diffing 1k site exceptions with BraveCookieRules finds the
+// same changes as the nested find_if loops used before.
+TEST(BraveCookieRulesTest, ThousandSiteExceptions) {
+  const int kSiteCount = 1000;
+  std::vector<Rule> old_rules = MakeSiteRules(kSiteCount, 0);
+  // Change 100 sites and remove the last 50.
+  std::vector<Rule> new_rules = MakeSiteRules(kSiteCount - 50, 100);
+
+  std::vector<Rule> expected = GetChangesWithFindIf(old_rules, new_rules);
+  ASSERT_EQ(150u, expected.size());
+
+  auto old_cookie_rules =
+      base::MakeRefCounted<BraveCookieRules>(CopyRules(old_rules));
+  auto new_cookie_rules =
+      base::MakeRefCounted<BraveCookieRules>(CopyRules(new_rules));
+  ExpectSameRules(expected,
+                  new_cookie_rules->GetChangesSince(old_cookie_rules.get()));
+
+  std::unique_ptr<RuleIterator> iterator = new_cookie_rules->CreateIterator();
+  std::vector<Rule> iterated;
+  while (iterator->HasNext())
+    iterated.push_back(iterator->Next());
+  ExpectSameRules(new_rules, iterated);
+}
+
+}  // namespace content_settings
@@ -100,6 +100,7 @@ void BraveContentSettingsAgentImpl::DidCommitProvisionalLoad(
     ui::PageTransition transition) {
   temporarily_allowed_scripts_ =
       std::move(preloaded_temporarily_allowed_scripts_);
+  cached_farbling_level_.reset();
   ContentSettingsAgentImpl::DidCommitProvisionalLoad(transition);
 }
 
@@ -188,17 +189,24 @@ bool BraveContentSettingsAgentImpl::AllowFingerprinting(
     bool enabled_per_settings) {
   if (!enabled_per_settings)
     return false;
-  blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
-  const GURL secondary_url(
-      url::Origin(frame->GetDocument().GetSecurityOrigin()).GetURL());
-  if (IsBraveShieldsDown(frame, secondary_url)) {
-    return true;
-  }
-
+  // The level is OFF when shields are down.
   return GetBraveFarblingLevel() != BraveFarblingLevel::MAXIMUM;
 }
 
 BraveFarblingLevel BraveContentSettingsAgentImpl::GetBraveFarblingLevel() {
+  if (!content_setting_rules_)
+    return ComputeBraveFarblingLevel();
+  if (!cached_farbling_level_ ||
+      cached_farbling_level_rules_generation_ !=
+          content_setting_rules_->brave_rules_generation) {
+    cached_farbling_level_ = ComputeBraveFarblingLevel();
+    cached_farbling_level_rules_generation_ =
+        content_setting_rules_->brave_rules_generation;
+  }
+  return *cached_farbling_level_;
+}
+
+BraveFarblingLevel BraveContentSettingsAgentImpl::ComputeBraveFarblingLevel() {
   blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
 
   ContentSetting setting = CONTENT_SETTING_DEFAULT;
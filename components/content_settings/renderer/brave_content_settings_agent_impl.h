@@ -10,6 +10,7 @@
 #include <string>
 #include <vector>
 
+#include "base/optional.h"
 #include "base/strings/string16.h"
 #include "brave/third_party/blink/renderer/brave_farbling_constants.h"
 #include "components/content_settings/core/common/content_settings.h"
@@ -62,6 +63,8 @@ class BraveContentSettingsAgentImpl : public ContentSettingsAgentImpl {
 
   bool IsScriptTemporilyAllowed(const GURL& script_url);
 
+  BraveFarblingLevel ComputeBraveFarblingLevel();
+
   // Origins of scripts which are temporary allowed for this frame in the
   // current load
   base::flat_set<std::string> temporarily_allowed_scripts_;
@@ -72,6 +75,12 @@ class BraveContentSettingsAgentImpl : public ContentSettingsAgentImpl {
   // temporary allowed script origins we preloaded for the next load
   base::flat_set<std::string> preloaded_temporarily_allowed_scripts_;
 
+  // Farbling level of the current document. Farbled APIs ask for it on every
+  // call, so it is only recomputed when a new document commits or the browser
+  // pushes new rules.
+  base::Optional<BraveFarblingLevel> cached_farbling_level_;
+  uint64_t cached_farbling_level_rules_generation_ = 0;
+
   DISALLOW_COPY_AND_ASSIGN(BraveContentSettingsAgentImpl);
 };
 
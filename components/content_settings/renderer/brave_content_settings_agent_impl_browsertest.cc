@@ -448,6 +448,35 @@ IN_PROC_BROWSER_TEST_F(BraveContentSettingsAgentImplBrowserTest,
   EXPECT_EQ(kExpectedImageDataHashFarblingOff, hash);
 }
 
+IN_PROC_BROWSER_TEST_F(BraveContentSettingsAgentImplBrowserTest,
+                       FarblingFollowsSettingChangesWithoutReload) {
+  NavigateToPageWithIframe();
+  int hash = -1;
+  EXPECT_TRUE(
+      ExecuteScriptAndExtractInt(contents(), kGetImageDataScript, &hash));
+  EXPECT_EQ(kExpectedImageDataHashFarblingBalanced, hash);
+
+  // The renderer's cached farbling level must be dropped when new rules are
+  // pushed, not only when the page is reloaded.
+  AllowFingerprinting();
+  hash = -1;
+  EXPECT_TRUE(
+      ExecuteScriptAndExtractInt(contents(), kGetImageDataScript, &hash));
+  EXPECT_EQ(kExpectedImageDataHashFarblingOff, hash);
+
+  SetFingerprintingDefault();
+  hash = -1;
+  EXPECT_TRUE(
+      ExecuteScriptAndExtractInt(contents(), kGetImageDataScript, &hash));
+  EXPECT_EQ(kExpectedImageDataHashFarblingBalanced, hash);
+
+  ShieldsDown();
+  hash = -1;
+  EXPECT_TRUE(
+      ExecuteScriptAndExtractInt(contents(), kGetImageDataScript, &hash));
+  EXPECT_EQ(kExpectedImageDataHashFarblingOff, hash);
+}
+
 class BraveContentSettingsAgentImplV2BrowserTest
     : public BraveContentSettingsAgentImplBrowserTest {
  public:
@@ -0,0 +1,96 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/ntp_background_images/browser/ntp_background_images_cache.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/task/post_task.h"
+
+namespace ntp_background_images {
+
+namespace {
+
+base::Optional<std::string> ReadFileToString(const base::FilePath& path) {
+  std::string contents;
+  if (!base::ReadFileToString(path, &contents))
+    return base::Optional<std::string>();
+  return contents;
+}
+
+}  // namespace
+
+constexpr size_t NTPBackgroundImagesCache::kMaxCachedImages;
+
+NTPBackgroundImagesCache::NTPBackgroundImagesCache()
+    : images_(kMaxCachedImages) {}
+
+NTPBackgroundImagesCache::~NTPBackgroundImagesCache() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+}
+
+void NTPBackgroundImagesCache::GetImage(const base::FilePath& image_file_path,
+                                        ImageCallback callback) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  auto cached = images_.Get(image_file_path);
+  if (cached != images_.end()) {
+    std::move(callback).Run(cached->second);
+    return;
+  }
+
+  auto& callbacks = pending_reads_[{image_file_path, generation_}];
+  callbacks.push_back(std::move(callback));
+  if (callbacks.size() > 1)
+    return;
+
+  base::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::ThreadPool(), base::MayBlock()},
+      base::BindOnce(&ReadFileToString, image_file_path),
+      base::BindOnce(&NTPBackgroundImagesCache::OnImageRead,
+                     weak_factory_.GetWeakPtr(), image_file_path,
+                     generation_));
+}
+
+void NTPBackgroundImagesCache::Prefetch(const base::FilePath& image_file_path) {
+  if (image_file_path.empty())
+    return;
+  GetImage(image_file_path, base::DoNothing());
+}
+
+void NTPBackgroundImagesCache::Clear() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  images_.Clear();
+  ++generation_;
+}
+
+bool NTPBackgroundImagesCache::IsCachedForTesting(
+    const base::FilePath& image_file_path) const {
+  return images_.Peek(image_file_path) != images_.end();
+}
+
+void NTPBackgroundImagesCache::OnImageRead(
+    const base::FilePath& image_file_path,
+    int generation,
+    base::Optional<std::string> contents) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  scoped_refptr<base::RefCountedMemory> bytes;
+  if (contents) {
+    // Takes over the buffer instead of copying it.
+    bytes = base::RefCountedString::TakeString(&*contents);
+    if (generation == generation_)
+      images_.Put(image_file_path, bytes);
+  }
+
+  auto pending = pending_reads_.find({image_file_path, generation});
+  DCHECK(pending != pending_reads_.end());
+  std::vector<ImageCallback> callbacks = std::move(pending->second);
+  pending_reads_.erase(pending);
+  for (auto& callback : callbacks)
+    std::move(callback).Run(bytes);
+}
+
+}  // namespace ntp_background_images
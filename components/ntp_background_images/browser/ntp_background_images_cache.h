@@ -0,0 +1,75 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_NTP_BACKGROUND_IMAGES_BROWSER_NTP_BACKGROUND_IMAGES_CACHE_H_
+#define BRAVE_COMPONENTS_NTP_BACKGROUND_IMAGES_BROWSER_NTP_BACKGROUND_IMAGES_CACHE_H_
+
+#include <stddef.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/containers/flat_map.h"
+#include "base/containers/mru_cache.h"
+#include "base/files/file_path.h"
+#include "base/memory/ref_counted_memory.h"
+#include "base/memory/weak_ptr.h"
+#include "base/optional.h"
+#include "base/sequence_checker.h"
+
+namespace ntp_background_images {
+
+// Keeps the most recently used image files of the installed components in
+// memory, so that opening new tabs doesn't read the same multi-megabyte
+// wallpapers from disk again. Concurrent requests for a file that is being
+// read share a single read, unless the cache was cleared since it started.
+// Files are keyed by path. Super referral images don't live in versioned
+// directories, so |Clear()| must be called whenever component data changes.
+class NTPBackgroundImagesCache {
+ public:
+  // Runs with null if the file couldn't be read.
+  using ImageCallback =
+      base::OnceCallback<void(scoped_refptr<base::RefCountedMemory>)>;
+
+  static constexpr size_t kMaxCachedImages = 4;
+
+  NTPBackgroundImagesCache();
+  ~NTPBackgroundImagesCache();
+
+  NTPBackgroundImagesCache(const NTPBackgroundImagesCache&) = delete;
+  NTPBackgroundImagesCache& operator=(const NTPBackgroundImagesCache&) = delete;
+
+  void GetImage(const base::FilePath& image_file_path, ImageCallback callback);
+  // Reads |image_file_path| into the cache ahead of the first request.
+  void Prefetch(const base::FilePath& image_file_path);
+  // Drops all cached images. Reads in progress still answer their callers
+  // but are not cached.
+  void Clear();
+
+  bool IsCachedForTesting(const base::FilePath& image_file_path) const;
+
+ private:
+  void OnImageRead(const base::FilePath& image_file_path,
+                   int generation,
+                   base::Optional<std::string> contents);
+
+  base::MRUCache<base::FilePath, scoped_refptr<base::RefCountedMemory>>
+      images_;
+  // Keyed by path and generation, so that requests made after |Clear()|
+  // don't join a read of the old file.
+  base::flat_map<std::pair<base::FilePath, int>, std::vector<ImageCallback>>
+      pending_reads_;
+  // Incremented by |Clear()| to tell stale reads apart.
+  int generation_ = 0;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+  base::WeakPtrFactory<NTPBackgroundImagesCache> weak_factory_{this};
+};
+
+}  // namespace ntp_background_images
+
+#endif  // BRAVE_COMPONENTS_NTP_BACKGROUND_IMAGES_BROWSER_NTP_BACKGROUND_IMAGES_CACHE_H_
@@ -0,0 +1,130 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/ntp_background_images/browser/ntp_background_images_cache.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/run_loop.h"
+#include "base/strings/stringprintf.h"
+#include "base/task/thread_pool/thread_pool_instance.h"
+#include "base/test/task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=NTPBackgroundImagesCacheTest.*
+
+namespace ntp_background_images {
+
+class NTPBackgroundImagesCacheTest : public testing::Test {
+ public:
+  void SetUp() override { ASSERT_TRUE(temp_dir_.CreateUniqueTempDir()); }
+
+ protected:
+  base::FilePath WriteImage(const std::string& name,
+                            const std::string& contents) {
+    base::FilePath path = temp_dir_.GetPath().AppendASCII(name);
+    EXPECT_TRUE(base::WriteFile(path, contents));
+    return path;
+  }
+
+  // Returns the image contents, or "<null>" if it couldn't be read.
+  std::string GetImage(const base::FilePath& path) {
+    std::string result;
+    base::RunLoop run_loop;
+    cache_.GetImage(
+        path, base::BindOnce(
+                  [](std::string* result, base::OnceClosure quit,
+                     scoped_refptr<base::RefCountedMemory> bytes) {
+                    *result = bytes ? std::string(bytes->front_as<char>(),
+                                                  bytes->size())
+                                    : "<null>";
+                    std::move(quit).Run();
+                  },
+                  &result, run_loop.QuitClosure()));
+    run_loop.Run();
+    return result;
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  base::ScopedTempDir temp_dir_;
+  NTPBackgroundImagesCache cache_;
+};
+
+TEST_F(NTPBackgroundImagesCacheTest, ServesCachedImages) {
+  const base::FilePath path = WriteImage("wallpaper-0.jpg", "first");
+  EXPECT_EQ("first", GetImage(path));
+  EXPECT_TRUE(cache_.IsCachedForTesting(path));
+
+  // Served from memory even though the file changed.
+  WriteImage("wallpaper-0.jpg", "second");
+  EXPECT_EQ("first", GetImage(path));
+
+  // New component data drops the cache.
+  cache_.Clear();
+  EXPECT_FALSE(cache_.IsCachedForTesting(path));
+  EXPECT_EQ("second", GetImage(path));
+
+  EXPECT_EQ("<null>", GetImage(temp_dir_.GetPath().AppendASCII("missing")));
+}
+
+TEST_F(NTPBackgroundImagesCacheTest, IsBounded) {
+  std::vector<base::FilePath> paths;
+  for (size_t i = 0; i <= NTPBackgroundImagesCache::kMaxCachedImages; ++i) {
+    paths.push_back(WriteImage(base::StringPrintf("wallpaper-%zu.jpg", i),
+                               base::StringPrintf("image %zu", i)));
+    EXPECT_EQ(base::StringPrintf("image %zu", i), GetImage(paths.back()));
+  }
+  EXPECT_FALSE(cache_.IsCachedForTesting(paths.front()));
+  for (size_t i = 1; i < paths.size(); ++i)
+    EXPECT_TRUE(cache_.IsCachedForTesting(paths[i]));
+}
+
+TEST_F(NTPBackgroundImagesCacheTest, PrefetchSharesRead) {
+  const base::FilePath path = WriteImage("logo.png", "logo");
+  cache_.Prefetch(path);
+  EXPECT_FALSE(cache_.IsCachedForTesting(path));
+  EXPECT_EQ("logo", GetImage(path));
+  EXPECT_TRUE(cache_.IsCachedForTesting(path));
+}
+
+TEST_F(NTPBackgroundImagesCacheTest, ClearDoesNotShareStaleRead) {
+  const base::FilePath path = WriteImage("wallpaper-0.jpg", "first");
+  std::vector<std::string> results;
+  auto on_image = base::BindRepeating(
+      [](std::vector<std::string>* results,
+         scoped_refptr<base::RefCountedMemory> bytes) {
+        results->push_back(std::string(bytes->front_as<char>(), bytes->size()));
+      },
+      &results);
+
+  // Finish reading the old file, but don't deliver it yet.
+  cache_.GetImage(path, on_image);
+  base::ThreadPoolInstance::Get()->FlushForTesting();
+
+  WriteImage("wallpaper-0.jpg", "second");
+  cache_.Clear();
+  EXPECT_EQ("second", GetImage(path));
+  EXPECT_EQ("second", GetImage(path));
+  EXPECT_EQ(std::vector<std::string>({"first"}), results);
+}
+
+// New tabs keep getting a multi-megabyte wallpaper without going back to
+// disk.
+TEST_F(NTPBackgroundImagesCacheTest, ServesLargeImagesFromMemory) {
+  const std::string contents(4 * 1024 * 1024, 'x');
+  const base::FilePath path = WriteImage("wallpaper-1.jpg", contents);
+  EXPECT_EQ(contents, GetImage(path));
+
+  ASSERT_TRUE(base::DeleteFile(path, false));
+  for (int i = 0; i < 3; ++i)
+    EXPECT_EQ(contents, GetImage(path));
+}
+
+}  // namespace ntp_background_images
@@ -480,6 +480,9 @@ void NTPBackgroundImagesService::OnComponentReady(
 void NTPBackgroundImagesService::OnGetComponentJsonData(
     bool is_super_referral,
     const std::string& json_string) {
+  // Files of the previous data may have been replaced in place.
+  image_cache_.Clear();
+
   if (is_super_referral) {
     local_pref_->SetBoolean(
           prefs::kNewTabPageGetInitialSRComponentInProgress,
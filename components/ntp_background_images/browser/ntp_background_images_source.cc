@@ -14,6 +14,7 @@
 #include "base/memory/ref_counted_memory.h"
 #include "base/strings/stringprintf.h"
 #include "base/task/post_task.h"
+#include "brave/components/ntp_background_images/browser/ntp_background_images_cache.h"
 #include "brave/components/ntp_background_images/browser/ntp_background_images_data.h"
 #include "brave/components/ntp_background_images/browser/ntp_background_images_service.h"
 #include "brave/components/ntp_background_images/browser/url_constants.h"
@@ -86,7 +87,9 @@ void NTPBackgroundImagesSource::StartDataRequest(
         images_data->backgrounds[GetWallpaperIndexFromPath(path)].image_file;
   }
 
-  GetImageFile(image_file_path, std::move(callback));
+  // Component images are shared by all new tabs, so they are served from
+  // memory once read.
+  service_->image_cache()->GetImage(image_file_path, std::move(callback));
 }
 
 void NTPBackgroundImagesSource::GetImageFile(
@@ -103,13 +106,12 @@ void NTPBackgroundImagesSource::GetImageFile(
 void NTPBackgroundImagesSource::OnGotImageFile(
     GotDataCallback callback,
     base::Optional<std::string> input) {
-  if (!input)
+  if (!input) {
+    std::move(callback).Run(nullptr);
     return;
+  }
 
-  scoped_refptr<base::RefCountedMemory> bytes;
-  bytes = new base::RefCountedBytes(
-       reinterpret_cast<const unsigned char*>(input->c_str()), input->length());
-  std::move(callback).Run(std::move(bytes));
+  std::move(callback).Run(base::RefCountedString::TakeString(&*input));
 }
 
 std::string NTPBackgroundImagesSource::GetMimeType(const std::string& path) {
@@ -176,9 +176,21 @@ void ViewCounterService::RegisterPageView() {
   // or the user opt-in status changing.
   if (IsBrandedWallpaperActive()) {
     model_.RegisterPageView();
+    PrefetchCurrentWallpaper();
   }
 }
 
+void ViewCounterService::PrefetchCurrentWallpaper() {
+  // Warm the cache before the page showing this wallpaper asks for it.
+  auto* data = GetCurrentBrandedWallpaperData();
+  if (!data)
+    return;
+  const size_t index = model_.current_wallpaper_image_index();
+  if (index < data->backgrounds.size())
+    service_->image_cache()->Prefetch(data->backgrounds[index].image_file);
+  service_->image_cache()->Prefetch(data->logo_image_file);
+}
+
 bool ViewCounterService::ShouldShowBrandedWallpaper() const {
   return IsBrandedWallpaperActive() && model_.ShouldShowBrandedWallpaper();
 }
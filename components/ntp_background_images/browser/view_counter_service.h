@@ -107,6 +107,7 @@ class ViewCounterService : public KeyedService,
   bool ShouldShowBrandedWallpaper() const;
 
   void ResetModel();
+  void PrefetchCurrentWallpaper();
 
   NTPBackgroundImagesService* service_ = nullptr;  // not owned
   PrefService* prefs_ = nullptr;  // not owned
@@ -5,6 +5,8 @@
 
 #include "brave/components/p3a/brave_p3a_log_store.h"
 
+#include <algorithm>
+
 #include "base/logging.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/rand_util.h"
@@ -22,6 +24,14 @@ constexpr char kLogValueKey[] = "value";
 constexpr char kLogSentKey[] = "sent";
 constexpr char kLogTimestampKey[] = "timestamp";
 
+// Changes made within this interval are written to prefs in one update.
+constexpr base::TimeDelta kPersistDelay = base::TimeDelta::FromSeconds(10);
+
+bool IsP2AMetric(base::StringPiece histogram_name) {
+  return base::StartsWith(histogram_name, "Brave.P2A",
+                          base::CompareCase::SENSITIVE);
+}
+
 void RecordP3A(uint64_t answers_count) {
   int answer = 0;
   if (1 <= answers_count && answers_count < 5) {
@@ -43,12 +53,45 @@ BraveP3ALogStore::BraveP3ALogStore(Delegate* delegate,
   DCHECK(local_state);
 }
 
-BraveP3ALogStore::~BraveP3ALogStore() = default;
+BraveP3ALogStore::~BraveP3ALogStore() {
+  PersistPendingChanges();
+}
 
 void BraveP3ALogStore::RegisterPrefs(PrefRegistrySimple* registry) {
   registry->RegisterDictionaryPref(kPrefName);
 }
 
+void BraveP3ALogStore::PersistPendingChanges() {
+  persist_timer_.Stop();
+  if (pending_entries_.empty()) {
+    return;
+  }
+
+  DictionaryPrefUpdate update(local_state_, kPrefName);
+  for (const std::string& name : pending_entries_) {
+    auto iter = log_.find(name);
+    if (iter == log_.end()) {
+      update->RemovePath(name);
+      continue;
+    }
+    const LogEntry& entry = iter->second;
+    update->SetPath({name, kLogValueKey},
+                    base::Value(base::NumberToString(entry.value)));
+    update->SetPath({name, kLogSentKey}, base::Value(entry.sent));
+    update->SetPath({name, kLogTimestampKey},
+                    base::Value(entry.sent_timestamp.ToDoubleT()));
+  }
+  pending_entries_.clear();
+}
+
+void BraveP3ALogStore::MarkForPersisting(const std::string& histogram_name) {
+  pending_entries_.insert(histogram_name);
+  if (!persist_timer_.IsRunning()) {
+    persist_timer_.Start(FROM_HERE, kPersistDelay, this,
+                         &BraveP3ALogStore::PersistPendingChanges);
+  }
+}
+
 void BraveP3ALogStore::UpdateValue(const std::string& histogram_name,
                                    uint64_t value) {
   LogEntry& entry = log_[histogram_name];
@@ -57,43 +100,31 @@ void BraveP3ALogStore::UpdateValue(const std::string& histogram_name,
     DCHECK(entry.sent_timestamp.is_null());
     unsent_entries_.insert(histogram_name);
   }
-
-  // Update the persistent value.
-  DictionaryPrefUpdate update(local_state_, kPrefName);
-  update->SetPath({histogram_name, kLogValueKey},
-                  base::Value(base::NumberToString(value)));
-  update->SetPath({histogram_name, kLogSentKey}, base::Value(entry.sent));
+  MarkForPersisting(histogram_name);
 }
 
 void BraveP3ALogStore::RemoveValueIfExists(const std::string& histogram_name) {
   DCHECK(delegate_->IsActualMetric(histogram_name));
   log_.erase(histogram_name);
   unsent_entries_.erase(histogram_name);
+  MarkForPersisting(histogram_name);
 
-  // Update the persistent value.
-  DictionaryPrefUpdate update(local_state_, kPrefName);
-  update->RemovePath(histogram_name);
-
-  if (has_staged_log() && staged_entry_key_ == histogram_name) {
-    staged_entry_key_.clear();
+  if (std::find(staged_entry_keys_.begin(), staged_entry_keys_.end(),
+                histogram_name) != staged_entry_keys_.end()) {
+    staged_entry_keys_.clear();
     staged_log_.clear();
   }
 }
 
 void BraveP3ALogStore::ResetUploadStamps() {
   // Clear log entries flags.
-  DictionaryPrefUpdate update(local_state_, kPrefName);
   for (auto& pair : log_) {
     if (pair.second.sent) {
       DCHECK(!pair.second.sent_timestamp.is_null());
       DCHECK(!unsent_entries_.contains(pair.first));
 
       pair.second.ResetSentState();
-
-      // Update persistent values.
-      update->SetPath({pair.first, kLogSentKey}, base::Value(pair.second.sent));
-      update->SetPath({pair.first, kLogTimestampKey},
-                      base::Value(pair.second.sent_timestamp.ToDoubleT()));
+      MarkForPersisting(pair.first);
     }
   }
 
@@ -111,29 +142,27 @@ bool BraveP3ALogStore::has_unsent_logs() const {
 }
 
 bool BraveP3ALogStore::has_staged_log() const {
-  return !staged_entry_key_.empty();
+  return !staged_entry_keys_.empty();
 }
 
 const std::string& BraveP3ALogStore::staged_log() const {
-  DCHECK(!staged_entry_key_.empty());
-  auto iter = log_.find(staged_entry_key_);
-  DCHECK(iter != log_.end());
-
+  DCHECK(has_staged_log());
   return staged_log_;
 }
 
 std::string BraveP3ALogStore::staged_log_type() const {
-  DCHECK(!staged_entry_key_.empty());
-  auto iter = log_.find(staged_entry_key_);
-  DCHECK(iter != log_.end());
-
-  if (base::StartsWith(iter->first, "Brave.P2A",
-                       base::CompareCase::SENSITIVE)) {
+  DCHECK(has_staged_log());
+  // All staged entries share the type of the first one.
+  if (IsP2AMetric(staged_entry_keys_.front())) {
     return "p2a";
   }
   return "p3a";
 }
 
+size_t BraveP3ALogStore::staged_log_count() const {
+  return staged_entry_keys_.size();
+}
+
 const std::string& BraveP3ALogStore::staged_log_hash() const {
   NOTREACHED();
   return staged_log_hash_;
@@ -148,13 +177,40 @@ void BraveP3ALogStore::StageNextLog() {
   // Stage the next item.
   DCHECK(has_unsent_logs());
   uint64_t rand_idx = base::RandGenerator(unsent_entries_.size());
-  staged_entry_key_ = *(unsent_entries_.begin() + rand_idx);
-  DCHECK(!log_.find(staged_entry_key_)->second.sent);
+  const std::string& first_key = *(unsent_entries_.begin() + rand_idx);
+  DCHECK(!log_.find(first_key)->second.sent);
+  staged_entry_keys_ = {first_key};
 
-  uint64_t staged_entry_value = log_[staged_entry_key_].value;
-  staged_log_ = delegate_->Serialize(staged_entry_key_, staged_entry_value);
+  if (max_batch_size_ <= 1) {
+    staged_log_ = delegate_->Serialize(first_key, log_[first_key].value);
+    VLOG(2) << "BraveP3ALogStore::StageNextLog: staged " << first_key;
+    return;
+  }
 
-  VLOG(2) << "BraveP3ALogStore::StageNextLog: staged " << staged_entry_key_;
+  // Fill the batch with other random unsent entries of the same type.
+  const bool is_p2a = IsP2AMetric(first_key);
+  std::vector<std::string> candidates;
+  for (const std::string& name : unsent_entries_) {
+    if (name != first_key && IsP2AMetric(name) == is_p2a) {
+      candidates.push_back(name);
+    }
+  }
+  base::RandomShuffle(candidates.begin(), candidates.end());
+  if (candidates.size() > max_batch_size_ - 1) {
+    candidates.resize(max_batch_size_ - 1);
+  }
+  staged_entry_keys_.insert(staged_entry_keys_.end(), candidates.begin(),
+                            candidates.end());
+
+  std::vector<std::pair<std::string, uint64_t>> entries;
+  entries.reserve(staged_entry_keys_.size());
+  for (const std::string& name : staged_entry_keys_) {
+    entries.emplace_back(name, log_[name].value);
+  }
+  staged_log_ = delegate_->SerializeBatch(entries);
+
+  VLOG(2) << "BraveP3ALogStore::StageNextLog: staged "
+          << staged_entry_keys_.size() << " entries";
 }
 
 void BraveP3ALogStore::DiscardStagedLog() {
@@ -162,24 +218,20 @@ void BraveP3ALogStore::DiscardStagedLog() {
     return;
   }
 
-  // Mark previous staged log as sent.
-  auto log_iter = log_.find(staged_entry_key_);
-  DCHECK(log_iter != log_.end());
-  log_iter->second.MarkAsSent();
-
-  // Update the persistent value.
-  DictionaryPrefUpdate update(local_state_, kPrefName);
-  update->SetPath({log_iter->first, kLogSentKey},
-                  base::Value(log_iter->second.sent));
-  update->SetPath({log_iter->first, kLogTimestampKey},
-                  base::Value(log_iter->second.sent_timestamp.ToDoubleT()));
-
-  // Erase the entry from the unsent queue.
-  auto unsent_entries_iter = unsent_entries_.find(staged_entry_key_);
-  DCHECK(unsent_entries_iter != unsent_entries_.end());
-  unsent_entries_.erase(unsent_entries_iter);
+  for (const std::string& name : staged_entry_keys_) {
+    // Mark previous staged log as sent.
+    auto log_iter = log_.find(name);
+    DCHECK(log_iter != log_.end());
+    log_iter->second.MarkAsSent();
+    MarkForPersisting(name);
+
+    // Erase the entry from the unsent queue.
+    auto unsent_entries_iter = unsent_entries_.find(name);
+    DCHECK(unsent_entries_iter != unsent_entries_.end());
+    unsent_entries_.erase(unsent_entries_iter);
+  }
 
-  staged_entry_key_.clear();
+  staged_entry_keys_.clear();
   staged_log_.clear();
 }
 
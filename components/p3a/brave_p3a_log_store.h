@@ -7,11 +7,14 @@
 #define BRAVE_COMPONENTS_P3A_BRAVE_P3A_LOG_STORE_H_
 
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "base/containers/flat_map.h"
 #include "base/containers/flat_set.h"
 #include "base/strings/string_piece.h"
 #include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "components/metrics/log_store.h"
 
 class PrefService;
@@ -19,7 +22,8 @@ class PrefRegistrySimple;
 
 namespace brave {
 
-// Stores all given values in memory and persists in prefs on the fly.
+// Stores all given values in memory and persists them in prefs shortly after
+// they change, coalescing all changes made meanwhile into a single update.
 // All logs (not only unsent are persistent), and all logs could be loaded
 // using |LoadPersistedUnsentLogs()|. We should fix this at some point since
 // for now persisted entries never expire.
@@ -30,6 +34,10 @@ class BraveP3ALogStore : public metrics::LogStore {
     // Prepares a string representaion of an entry.
     virtual std::string Serialize(base::StringPiece histogram_name,
                                   uint64_t value) const = 0;
+    // Prepares a string representation of entries uploaded together.
+    virtual std::string SerializeBatch(
+        const std::vector<std::pair<std::string, uint64_t>>& entries)
+        const = 0;
     // Returns false if the metric is obsolete and should be cleaned up.
     virtual bool IsActualMetric(base::StringPiece histogram_name) const = 0;
     virtual ~Delegate() {}
@@ -43,6 +51,15 @@ class BraveP3ALogStore : public metrics::LogStore {
 
   static void RegisterPrefs(PrefRegistrySimple* registry);
 
+  // When greater than 1, up to this many values of the same type are staged
+  // together and serialized with |Delegate::SerializeBatch()|.
+  void set_max_batch_size(size_t max_batch_size) {
+    max_batch_size_ = max_batch_size;
+  }
+
+  // Writes changes that are waiting to be persisted right away.
+  void PersistPendingChanges();
+
   void UpdateValue(const std::string& histogram_name, uint64_t value);
   // Removes and also unstages the metric value if it is known and/or staged.
   void RemoveValueIfExists(const std::string& histogram_name);
@@ -54,6 +71,8 @@ class BraveP3ALogStore : public metrics::LogStore {
   bool has_staged_log() const override;
   const std::string& staged_log() const override;
   std::string staged_log_type() const;
+  // Number of values serialized into |staged_log()|.
+  size_t staged_log_count() const;
   const std::string& staged_log_hash() const override;
   const std::string& staged_log_signature() const override;
   void StageNextLog() override;
@@ -84,14 +103,23 @@ class BraveP3ALogStore : public metrics::LogStore {
     base::Time sent_timestamp;  // At the moment only for debugging purposes.
   };
 
+  // Schedules persisting the entry, or its removal if it is not in |log_|.
+  void MarkForPersisting(const std::string& histogram_name);
+
   const Delegate* const delegate_ = nullptr;  // Weak.
   PrefService* const local_state_ = nullptr;
+  size_t max_batch_size_ = 1;
 
   // TODO(iefremov): Try to replace with base::StringPiece?
   base::flat_map<std::string, LogEntry> log_;
   base::flat_set<std::string> unsent_entries_;
 
-  std::string staged_entry_key_;
+  // Entries changed since the last time they were persisted.
+  base::flat_set<std::string> pending_entries_;
+  base::OneShotTimer persist_timer_;
+
+  // All staged entries have the same log type.
+  std::vector<std::string> staged_entry_keys_;
   std::string staged_log_;
 
   // Not used for now.
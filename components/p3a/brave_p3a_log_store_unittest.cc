@@ -0,0 +1,165 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/p3a/brave_p3a_log_store.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
+#include "base/test/task_environment.h"
+#include "components/prefs/pref_change_registrar.h"
+#include "components/prefs/testing_pref_service.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=BraveP3ALogStoreTest.*
+
+namespace brave {
+
+namespace {
+
+constexpr char kPrefName[] = "p3a.logs";
+
+class TestDelegate : public BraveP3ALogStore::Delegate {
+ public:
+  std::string Serialize(base::StringPiece histogram_name,
+                        uint64_t value) const override {
+    return histogram_name.as_string() + "=" + base::NumberToString(value);
+  }
+
+  std::string SerializeBatch(
+      const std::vector<std::pair<std::string, uint64_t>>& entries)
+      const override {
+    std::vector<std::string> parts;
+    for (const auto& entry : entries)
+      parts.push_back(Serialize(entry.first, entry.second));
+    return base::JoinString(parts, ",");
+  }
+
+  bool IsActualMetric(base::StringPiece histogram_name) const override {
+    return true;
+  }
+};
+
+}  // namespace
+
+class BraveP3ALogStoreTest : public ::testing::Test {
+ public:
+  BraveP3ALogStoreTest() {
+    BraveP3ALogStore::RegisterPrefs(local_state_.registry());
+    log_store_ = std::make_unique<BraveP3ALogStore>(&delegate_, &local_state_);
+    log_store_->LoadPersistedUnsentLogs();
+
+    registrar_.Init(&local_state_);
+    registrar_.Add(kPrefName,
+                   base::BindRepeating([](int* count) { ++*count; },
+                                       &pref_updates_));
+  }
+
+ protected:
+  const base::Value* GetPersistedEntry(const std::string& name) {
+    return local_state_.GetDictionary(kPrefName)->FindDictKey(name);
+  }
+
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  TestDelegate delegate_;
+  TestingPrefServiceSimple local_state_;
+  std::unique_ptr<BraveP3ALogStore> log_store_;
+  PrefChangeRegistrar registrar_;
+  int pref_updates_ = 0;
+};
+
+TEST_F(BraveP3ALogStoreTest, CoalescesPrefUpdates) {
+  for (int i = 0; i < 20; ++i)
+    log_store_->UpdateValue("Brave.P3A.Metric" + base::NumberToString(i), i);
+  log_store_->UpdateValue("Brave.P3A.Metric0", 5);
+  log_store_->RemoveValueIfExists("Brave.P3A.Metric1");
+  EXPECT_EQ(0, pref_updates_);
+  EXPECT_FALSE(GetPersistedEntry("Brave.P3A.Metric0"));
+
+  task_environment_.FastForwardBy(base::TimeDelta::FromMinutes(1));
+  EXPECT_EQ(1, pref_updates_);
+  const base::Value* entry = GetPersistedEntry("Brave.P3A.Metric0");
+  ASSERT_TRUE(entry);
+  EXPECT_EQ("5", *entry->FindStringKey("value"));
+  EXPECT_FALSE(*entry->FindBoolKey("sent"));
+  EXPECT_FALSE(GetPersistedEntry("Brave.P3A.Metric1"));
+
+  // Sending a value is persisted as well, and pending changes are written
+  // when asked to.
+  log_store_->StageNextLog();
+  log_store_->DiscardStagedLog();
+  log_store_->PersistPendingChanges();
+  EXPECT_EQ(2, pref_updates_);
+
+  // Everything persisted can be loaded back.
+  BraveP3ALogStore loaded_store(&delegate_, &local_state_);
+  loaded_store.LoadPersistedUnsentLogs();
+  size_t unsent_count = 0;
+  while (loaded_store.has_unsent_logs()) {
+    loaded_store.StageNextLog();
+    loaded_store.DiscardStagedLog();
+    ++unsent_count;
+  }
+  EXPECT_EQ(18u, unsent_count);
+}
+
+TEST_F(BraveP3ALogStoreTest, StagesSingleValueByDefault) {
+  log_store_->UpdateValue("Brave.P3A.A", 1);
+  log_store_->UpdateValue("Brave.P3A.B", 2);
+
+  log_store_->StageNextLog();
+  EXPECT_EQ(1u, log_store_->staged_log_count());
+  const std::string log = log_store_->staged_log();
+  EXPECT_TRUE(log == "Brave.P3A.A=1" || log == "Brave.P3A.B=2") << log;
+  log_store_->DiscardStagedLog();
+  EXPECT_TRUE(log_store_->has_unsent_logs());
+}
+
+TEST_F(BraveP3ALogStoreTest, StagesBatchesOfTheSameType) {
+  log_store_->set_max_batch_size(3);
+  for (int i = 0; i < 4; ++i)
+    log_store_->UpdateValue("Brave.P3A.Metric" + base::NumberToString(i), i);
+  log_store_->UpdateValue("Brave.P2A.Metric", 7);
+
+  size_t p3a_count = 0;
+  size_t p2a_count = 0;
+  size_t upload_count = 0;
+  while (log_store_->has_unsent_logs()) {
+    log_store_->StageNextLog();
+    if (log_store_->staged_log_type() == "p2a") {
+      EXPECT_EQ("Brave.P2A.Metric=7", log_store_->staged_log());
+      p2a_count += log_store_->staged_log_count();
+    } else {
+      EXPECT_LE(log_store_->staged_log_count(), 3u);
+      EXPECT_EQ(std::string::npos, log_store_->staged_log().find("P2A"));
+      p3a_count += log_store_->staged_log_count();
+    }
+    log_store_->DiscardStagedLog();
+    ++upload_count;
+  }
+  EXPECT_EQ(4u, p3a_count);
+  EXPECT_EQ(1u, p2a_count);
+  EXPECT_EQ(3u, upload_count);
+
+  // Removing any of the staged values unstages the whole batch.
+  log_store_->ResetUploadStamps();
+  log_store_->StageNextLog();
+  log_store_->RemoveValueIfExists("Brave.P2A.Metric");
+  for (int i = 0; i < 4; ++i) {
+    if (!log_store_->has_staged_log())
+      break;
+    log_store_->RemoveValueIfExists("Brave.P3A.Metric" +
+                                    base::NumberToString(i));
+  }
+  EXPECT_FALSE(log_store_->has_staged_log());
+}
+
+}  // namespace brave
@@ -158,6 +158,7 @@ void BraveP3AService::Init(
   VLOG(2) << "BraveP3AService parameters are:"
           << ", average_upload_interval_ = " << average_upload_interval_
           << ", randomize_upload_interval_ = " << randomize_upload_interval_
+          << ", upload_batch_size_ = " << upload_batch_size_
           << ", upload_server_url_ = " << upload_server_url_.spec()
           << ", rotation_interval_ = " << rotation_interval_;
 
@@ -165,6 +166,7 @@ void BraveP3AService::Init(
 
   // Init log store.
   log_store_.reset(new BraveP3ALogStore(this, local_state_));
+  log_store_->set_max_batch_size(upload_batch_size_);
   log_store_->LoadPersistedUnsentLogs();
   // Store values that were recorded between calling constructor and |Init()|.
   for (const auto& entry : histogram_values_) {
@@ -204,6 +206,11 @@ void BraveP3AService::Init(
   }
 }
 
+void BraveP3AService::StartTeardown() {
+  if (log_store_)
+    log_store_->PersistPendingChanges();
+}
+
 std::string BraveP3AService::Serialize(base::StringPiece histogram_name,
                                        uint64_t value) const {
   // TRACE_EVENT0("brave_p3a", "SerializeMessage");
@@ -224,6 +231,16 @@ std::string BraveP3AService::Serialize(base::StringPiece histogram_name,
   return message.SerializeAsString();
 }
 
+std::string BraveP3AService::SerializeBatch(
+    const std::vector<std::pair<std::string, uint64_t>>& entries) const {
+  brave_pyxis::RawP3AValueList batch;
+  for (const auto& entry : entries) {
+    prochlo::GenerateP3AMessage(base::HashMetricName(entry.first),
+                                entry.second, pyxis_meta_, batch.add_values());
+  }
+  return batch.SerializeAsString();
+}
+
 bool
 BraveP3AService::IsActualMetric(base::StringPiece histogram_name) const {
   static const base::NoDestructor<base::flat_set<base::StringPiece>>
@@ -244,6 +261,17 @@ void BraveP3AService::MaybeOverrideSettingsFromCommandLine() {
     }
   }
 
+  if (cmdline->HasSwitch(switches::kP3AUploadBatchSize)) {
+    std::string batch_size_str =
+        cmdline->GetSwitchValueASCII(switches::kP3AUploadBatchSize);
+    size_t batch_size;
+    if (base::StringToSizeT(batch_size_str, &batch_size) && batch_size > 0) {
+      upload_batch_size_ = batch_size;
+      // Keep the average number of values sent per unit of time.
+      average_upload_interval_ *= static_cast<int64_t>(batch_size);
+    }
+  }
+
   if (cmdline->HasSwitch(switches::kP3ADoNotRandomizeUploadInterval)) {
     randomize_upload_interval_ = false;
   }
@@ -313,9 +341,10 @@ void BraveP3AService::StartScheduledUpload() {
   if (p3a_enabled) {
     const std::string log = log_store_->staged_log();
     const std::string log_type = log_store_->staged_log_type();
+    const size_t log_count = log_store_->staged_log_count();
     VLOG(2) << "StartScheduledUpload - Uploading " << log.size() << " bytes "
-            << "of type " << log_type;
-    uploader_->UploadLog(log, log_type);
+            << "of type " << log_type << " with " << log_count << " values";
+    uploader_->UploadLog(log, log_type, upload_batch_size_ > 1);
   }
 }
 
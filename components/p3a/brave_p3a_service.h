@@ -8,6 +8,8 @@
 
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "base/containers/flat_map.h"
 #include "base/memory/ref_counted.h"
@@ -47,9 +49,16 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
   void Init(
       scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory);
 
+  // Writes pending log changes to local state. Should be called before local
+  // state is committed for the last time during shutdown.
+  void StartTeardown();
+
   // BraveP3ALogStore::Delegate
   std::string Serialize(base::StringPiece histogram_name,
                         uint64_t value) const override;
+  std::string SerializeBatch(
+      const std::vector<std::pair<std::string, uint64_t>>& entries)
+      const override;
 
   // May be accessed from multiple threads, so this is thread-safe.
   bool IsActualMetric(base::StringPiece histogram_name) const override;
@@ -90,6 +99,8 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
   // The average interval between uploading different values.
   base::TimeDelta average_upload_interval_;
   bool randomize_upload_interval_ = true;
+  // Maximal number of values sent in one request.
+  size_t upload_batch_size_ = 1;
   // Interval between rotations, only used for testing from the command line.
   base::TimeDelta rotation_interval_;
   GURL upload_server_url_;
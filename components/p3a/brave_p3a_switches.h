@@ -19,6 +19,10 @@ constexpr char kP3ADoNotRandomizeUploadInterval[] =
 // Interval between restarting the uploading process for all gathered values.
 constexpr char kP3ARotationIntervalSeconds[] = "p3a-rotation-interval-seconds";
 
+// Maximal number of values sent in a single request. The upload interval is
+// scaled by the same factor, so values are sent at the same average rate.
+constexpr char kP3AUploadBatchSize[] = "p3a-upload-batch-size";
+
 // P3A cloud backend URL.
 constexpr char kP3AUploadServerUrl[] = "p3a-upload-server-url";
 
@@ -80,7 +80,8 @@ BraveP3AUploader::BraveP3AUploader(
 BraveP3AUploader::~BraveP3AUploader() = default;
 
 void BraveP3AUploader::UploadLog(const std::string& compressed_log_data,
-                                 const std::string& upload_type) {
+                                 const std::string& upload_type,
+                                 bool is_batch) {
   auto resource_request = std::make_unique<network::ResourceRequest>();
   if (upload_type == "p2a") {
     resource_request->url = p2a_endpoint_;
@@ -91,6 +92,9 @@ void BraveP3AUploader::UploadLog(const std::string& compressed_log_data,
   } else {
     NOTREACHED();
   }
+  if (is_batch) {
+    resource_request->headers.SetHeader("X-Brave-P3A-Batch", "?1");
+  }
 
   resource_request->credentials_mode = network::mojom::CredentialsMode::kOmit;
   resource_request->method = "POST";
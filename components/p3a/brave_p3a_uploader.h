@@ -33,8 +33,10 @@ class BraveP3AUploader {
   ~BraveP3AUploader();
 
   // From metrics::MetricsLogUploader
+  // |is_batch| marks logs holding a list of values rather than a single one.
   void UploadLog(const std::string& compressed_log_data,
-                 const std::string& upload_type);
+                 const std::string& upload_type,
+                 bool is_batch = false);
 
   void OnUploadComplete(std::unique_ptr<std::string> response_body);
 
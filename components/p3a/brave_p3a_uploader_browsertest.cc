@@ -0,0 +1,130 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+#include <string>
+
+#include "base/base64.h"
+#include "base/bind.h"
+#include "base/run_loop.h"
+#include "brave/components/p3a/brave_p3a_uploader.h"
+#include "chrome/browser/browser_process.h"
+#include "chrome/test/base/in_process_browser_test.h"
+#include "content/public/test/browser_test.h"
+#include "net/http/http_status_code.h"
+#include "net/test/embedded_test_server/embedded_test_server.h"
+#include "net/test/embedded_test_server/http_request.h"
+#include "net/test/embedded_test_server/http_response.h"
+#include "services/network/public/cpp/shared_url_loader_factory.h"
+
+// npm run test -- brave_browser_tests --filter=BraveP3AUploaderBrowserTest.*
+
+namespace brave {
+
+namespace {
+
+constexpr char kP3APath[] = "/p3a";
+constexpr char kP2APath[] = "/p2a";
+
+}  // namespace
+
+class BraveP3AUploaderBrowserTest : public InProcessBrowserTest {
+ public:
+  void SetUpOnMainThread() override {
+    InProcessBrowserTest::SetUpOnMainThread();
+    embedded_test_server()->RegisterRequestHandler(
+        base::BindRepeating(&BraveP3AUploaderBrowserTest::HandleRequest,
+                            base::Unretained(this)));
+    ASSERT_TRUE(embedded_test_server()->Start());
+
+    uploader_ = std::make_unique<BraveP3AUploader>(
+        g_browser_process->shared_url_loader_factory(),
+        embedded_test_server()->GetURL(kP3APath),
+        embedded_test_server()->GetURL(kP2APath),
+        base::BindRepeating(&BraveP3AUploaderBrowserTest::OnUploadComplete,
+                            base::Unretained(this)));
+  }
+
+  void TearDownOnMainThread() override {
+    uploader_.reset();
+    InProcessBrowserTest::TearDownOnMainThread();
+  }
+
+  std::unique_ptr<net::test_server::HttpResponse> HandleRequest(
+      const net::test_server::HttpRequest& request) {
+    // Called on the test server's IO thread. The upload callback, which quits
+    // the run loop, only runs after the response has been sent.
+    last_request_ = std::make_unique<net::test_server::HttpRequest>(request);
+    auto http_response =
+        std::make_unique<net::test_server::BasicHttpResponse>();
+    http_response->set_code(net::HTTP_OK);
+    return std::move(http_response);
+  }
+
+  void OnUploadComplete(int response_code, int error_code, bool was_https) {
+    response_code_ = response_code;
+    if (run_loop_)
+      run_loop_->Quit();
+  }
+
+  void Upload(const std::string& log,
+              const std::string& upload_type,
+              bool is_batch) {
+    last_request_.reset();
+    response_code_ = -1;
+    run_loop_ = std::make_unique<base::RunLoop>();
+    uploader_->UploadLog(log, upload_type, is_batch);
+    run_loop_->Run();
+  }
+
+ protected:
+  std::unique_ptr<BraveP3AUploader> uploader_;
+  std::unique_ptr<net::test_server::HttpRequest> last_request_;
+  int response_code_ = -1;
+
+ private:
+  std::unique_ptr<base::RunLoop> run_loop_;
+};
+
+IN_PROC_BROWSER_TEST_F(BraveP3AUploaderBrowserTest, UploadsSingleValue) {
+  Upload("single value", "p3a", false);
+
+  EXPECT_EQ(net::HTTP_OK, response_code_);
+  ASSERT_TRUE(last_request_);
+  EXPECT_EQ(kP3APath, last_request_->relative_url);
+  EXPECT_EQ(net::test_server::METHOD_POST, last_request_->method);
+  EXPECT_EQ(1u, last_request_->headers.count("X-Brave-P3A"));
+  EXPECT_EQ(0u, last_request_->headers.count("X-Brave-P3A-Batch"));
+  std::string content;
+  ASSERT_TRUE(base::Base64Decode(last_request_->content, &content));
+  EXPECT_EQ("single value", content);
+}
+
+IN_PROC_BROWSER_TEST_F(BraveP3AUploaderBrowserTest, UploadsBatch) {
+  Upload("batch of values", "p3a", true);
+
+  EXPECT_EQ(net::HTTP_OK, response_code_);
+  ASSERT_TRUE(last_request_);
+  EXPECT_EQ(kP3APath, last_request_->relative_url);
+  EXPECT_EQ(1u, last_request_->headers.count("X-Brave-P3A"));
+  ASSERT_EQ(1u, last_request_->headers.count("X-Brave-P3A-Batch"));
+  EXPECT_EQ("?1", last_request_->headers.at("X-Brave-P3A-Batch"));
+  std::string content;
+  ASSERT_TRUE(base::Base64Decode(last_request_->content, &content));
+  EXPECT_EQ("batch of values", content);
+}
+
+IN_PROC_BROWSER_TEST_F(BraveP3AUploaderBrowserTest, UploadsP2ABatch) {
+  Upload("p2a batch", "p2a", true);
+
+  EXPECT_EQ(net::HTTP_OK, response_code_);
+  ASSERT_TRUE(last_request_);
+  EXPECT_EQ(kP2APath, last_request_->relative_url);
+  EXPECT_EQ(1u, last_request_->headers.count("X-Brave-P2A"));
+  EXPECT_EQ(0u, last_request_->headers.count("X-Brave-P3A"));
+  EXPECT_EQ(1u, last_request_->headers.count("X-Brave-P3A-Batch"));
+}
+
+}  // namespace brave
@@ -12,11 +12,27 @@
 #include "mojo/public/cpp/bindings/interface_request.h"
 #include "mojo/public/cpp/bindings/sync_call_restrictions.h"
 #include "base/logging.h"
+#include "base/metrics/histogram_functions.h"
+#include "base/time/time.h"
 
 namespace bat_ads {
 
 namespace {
 
+// Time from running a database transaction until its response arrives, for
+// transactions run directly on the browser database sequence and for those
+// run through the browser UI thread
+const char kDirectDBTransactionHistogramName[] =
+    "Brave.Ads.DBTransactionTime.Direct";
+const char kClientDBTransactionHistogramName[] =
+    "Brave.Ads.DBTransactionTime.BrowserUIThread";
+
+ads::DBCommandResponsePtr CreateDBErrorResponse() {
+  auto response = ads::DBCommandResponse::New();
+  response->status = ads::DBCommandResponse::Status::RESPONSE_ERROR;
+  return response;
+}
+
 ads::Result ToAdsResult(
     const int32_t result) {
   return (ads::Result)result;
@@ -27,8 +43,16 @@ ads::Result ToAdsResult(
 ///////////////////////////////////////////////////////////////////////////////
 
 BatAdsClientMojoBridge::BatAdsClientMojoBridge(
-    mojo::PendingAssociatedRemote<mojom::BatAdsClient> client_info) {
+    mojo::PendingAssociatedRemote<mojom::BatAdsClient> client_info,
+    mojo::PendingRemote<mojom::BatAdsDatabase> bat_ads_database) {
   bat_ads_client_.Bind(std::move(client_info));
+
+  if (bat_ads_database) {
+    bat_ads_database_.Bind(std::move(bat_ads_database));
+    bat_ads_database_.set_disconnect_handler(
+        base::BindOnce(&BatAdsClientMojoBridge::OnBatAdsDatabaseDisconnected,
+            base::Unretained(this)));
+  }
 }
 
 BatAdsClientMojoBridge::~BatAdsClientMojoBridge() = default;
@@ -305,15 +329,63 @@ std::string BatAdsClientMojoBridge::LoadResourceForId(
 
 void OnRunDBTransaction(
     const ads::RunDBTransactionCallback& callback,
+    const char* histogram_name,
+    const base::TimeTicks start_time,
     ads::DBCommandResponsePtr response) {
+  base::UmaHistogramTimes(histogram_name, base::TimeTicks::Now() - start_time);
+
   callback(std::move(response));
 }
 
 void BatAdsClientMojoBridge::RunDBTransaction(
     ads::DBTransactionPtr transaction,
     ads::RunDBTransactionCallback callback) {
+  const base::TimeTicks start_time = base::TimeTicks::Now();
+
+  if (bat_ads_database_.is_bound()) {
+    if (!bat_ads_database_.is_connected()) {
+      callback(CreateDBErrorResponse());
+      return;
+    }
+
+    const uint64_t transaction_id = next_direct_db_transaction_id_++;
+    direct_db_transactions_[transaction_id] = callback;
+
+    // Unretained is safe as |bat_ads_database_| does not run callbacks after
+    // it is destroyed
+    bat_ads_database_->RunTransaction(std::move(transaction),
+        base::BindOnce(&BatAdsClientMojoBridge::OnRunDirectDBTransaction,
+            base::Unretained(this), transaction_id, start_time));
+    return;
+  }
+
   bat_ads_client_->RunDBTransaction(std::move(transaction),
-      base::BindOnce(&OnRunDBTransaction, std::move(callback)));
+      base::BindOnce(&OnRunDBTransaction, std::move(callback),
+          kClientDBTransactionHistogramName, start_time));
+}
+
+void BatAdsClientMojoBridge::OnRunDirectDBTransaction(
+    const uint64_t transaction_id,
+    const base::TimeTicks start_time,
+    ads::DBCommandResponsePtr response) {
+  const auto iter = direct_db_transactions_.find(transaction_id);
+  DCHECK(iter != direct_db_transactions_.end());
+  const ads::RunDBTransactionCallback callback = iter->second;
+  direct_db_transactions_.erase(iter);
+
+  OnRunDBTransaction(callback, kDirectDBTransactionHistogramName, start_time,
+      std::move(response));
+}
+
+void BatAdsClientMojoBridge::OnBatAdsDatabaseDisconnected() {
+  // Transactions in flight when the browser resets the database are dropped
+  // without a response, so fail them as if the database was not there
+  std::map<uint64_t, ads::RunDBTransactionCallback> transactions;
+  transactions.swap(direct_db_transactions_);
+
+  for (const auto& transaction : transactions) {
+    transaction.second(CreateDBErrorResponse());
+  }
 }
 
 void BatAdsClientMojoBridge::OnAdRewardsChanged() {
@@ -6,22 +6,31 @@
 #ifndef BRAVE_COMPONENTS_SERVICES_BAT_ADS_BAT_ADS_CLIENT_MOJO_BRIDGE_H_
 #define BRAVE_COMPONENTS_SERVICES_BAT_ADS_BAT_ADS_CLIENT_MOJO_BRIDGE_H_
 
+#include <stdint.h>
+
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "base/time/time.h"
 #include "bat/ads/ads_client.h"
 #include "brave/components/services/bat_ads/public/interfaces/bat_ads.mojom.h"
 #include "mojo/public/cpp/bindings/associated_remote.h"
 #include "mojo/public/cpp/bindings/pending_associated_remote.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
+#include "mojo/public/cpp/bindings/remote.h"
 
 namespace bat_ads {
 
 class BatAdsClientMojoBridge
     : public ads::AdsClient {
  public:
-  explicit BatAdsClientMojoBridge(
-      mojo::PendingAssociatedRemote<mojom::BatAdsClient> client_info);
+  // Database transactions are run through |bat_ads_database| if it is valid,
+  // otherwise through |client_info|
+  BatAdsClientMojoBridge(
+      mojo::PendingAssociatedRemote<mojom::BatAdsClient> client_info,
+      mojo::PendingRemote<mojom::BatAdsDatabase> bat_ads_database);
 
   ~BatAdsClientMojoBridge() override;
 
@@ -97,7 +106,20 @@ class BatAdsClientMojoBridge
  private:
   bool connected() const;
 
+  void OnRunDirectDBTransaction(
+      const uint64_t transaction_id,
+      const base::TimeTicks start_time,
+      ads::DBCommandResponsePtr response);
+
+  void OnBatAdsDatabaseDisconnected();
+
   mojo::AssociatedRemote<mojom::BatAdsClient> bat_ads_client_;
+  mojo::Remote<mojom::BatAdsDatabase> bat_ads_database_;
+
+  // Callbacks of transactions sent to |bat_ads_database_| which have not been
+  // answered yet, so that they can fail if the browser resets the database
+  std::map<uint64_t, ads::RunDBTransactionCallback> direct_db_transactions_;
+  uint64_t next_direct_db_transaction_id_ = 0;
 };
 
 }  // namespace bat_ads
@@ -0,0 +1,166 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/services/bat_ads/bat_ads_client_mojo_bridge.h"
+
+#include <memory>
+#include <utility>
+
+#include "base/files/scoped_temp_dir.h"
+#include "base/macros.h"
+#include "base/run_loop.h"
+#include "base/test/task_environment.h"
+#include "bat/ads/database.h"
+#include "brave/components/services/bat_ads/public/cpp/ads_database_mojo_bridge.h"
+#include "mojo/public/cpp/bindings/pending_associated_remote.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=BatAdsClientMojoBridgeTest.*
+
+namespace bat_ads {
+
+namespace {
+
+ads::DBTransactionPtr CreateTransaction() {
+  auto transaction = ads::DBTransaction::New();
+  transaction->version = 1;
+  transaction->compatible_version = 1;
+
+  auto initialize_command = ads::DBCommand::New();
+  initialize_command->type = ads::DBCommand::Type::INITIALIZE;
+  transaction->commands.push_back(std::move(initialize_command));
+
+  auto create_command = ads::DBCommand::New();
+  create_command->type = ads::DBCommand::Type::EXECUTE;
+  create_command->command = "CREATE TABLE IF NOT EXISTS test (value TEXT)";
+  transaction->commands.push_back(std::move(create_command));
+
+  auto insert_command = ads::DBCommand::New();
+  insert_command->type = ads::DBCommand::Type::EXECUTE;
+  insert_command->command = "INSERT INTO test (value) VALUES ('foobar')";
+  transaction->commands.push_back(std::move(insert_command));
+
+  auto read_command = ads::DBCommand::New();
+  read_command->type = ads::DBCommand::Type::READ;
+  read_command->command = "SELECT value FROM test";
+  read_command->record_bindings = {
+    ads::DBCommand::RecordBindingType::STRING_TYPE
+  };
+  transaction->commands.push_back(std::move(read_command));
+
+  return transaction;
+}
+
+}  // namespace
+
+class BatAdsClientMojoBridgeTest : public ::testing::Test {
+ protected:
+  BatAdsClientMojoBridgeTest() = default;
+
+  ~BatAdsClientMojoBridgeTest() override = default;
+
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+
+    database_ = std::make_unique<ads::Database>(
+        temp_dir_.GetPath().AppendASCII("database.sqlite"));
+
+    // The database is bound to the test sequence, which stands in for the
+    // browser file task runner used when direct database access is enabled
+    mojo::PendingRemote<mojom::BatAdsDatabase> bat_ads_database;
+    database_bridge_ = std::make_unique<AdsDatabaseMojoBridge>(
+        database_.get());
+    database_bridge_->Bind(bat_ads_database.InitWithNewPipeAndPassReceiver());
+
+    // Transactions are not run through the client, so it is left unbound
+    mojo::PendingAssociatedRemote<mojom::BatAdsClient> bat_ads_client;
+    ignore_result(bat_ads_client.InitWithNewEndpointAndPassReceiver());
+
+    client_mojo_bridge_ = std::make_unique<BatAdsClientMojoBridge>(
+        std::move(bat_ads_client), std::move(bat_ads_database));
+  }
+
+  void RunDBTransaction(
+      ads::DBTransactionPtr transaction,
+      ads::DBCommandResponsePtr* response,
+      base::RepeatingClosure quit_closure) {
+    client_mojo_bridge_->RunDBTransaction(std::move(transaction),
+        [response, quit_closure](ads::DBCommandResponsePtr command_response) {
+          *response = std::move(command_response);
+          quit_closure.Run();
+        });
+  }
+
+  void ResetDatabase() {
+    // Same order as |AdsServiceImpl::ResetDatabase|
+    database_bridge_.reset();
+    database_.reset();
+  }
+
+  base::test::TaskEnvironment task_environment_;
+
+  base::ScopedTempDir temp_dir_;
+
+  std::unique_ptr<ads::Database> database_;
+  std::unique_ptr<AdsDatabaseMojoBridge> database_bridge_;
+
+  std::unique_ptr<BatAdsClientMojoBridge> client_mojo_bridge_;
+};
+
+TEST_F(BatAdsClientMojoBridgeTest,
+    RunDirectDBTransaction) {
+  // Arrange
+  ads::DBCommandResponsePtr response;
+
+  // Act
+  base::RunLoop run_loop;
+  RunDBTransaction(CreateTransaction(), &response, run_loop.QuitClosure());
+  run_loop.Run();
+
+  // Assert
+  ASSERT_TRUE(response);
+  EXPECT_EQ(ads::DBCommandResponse::Status::RESPONSE_OK, response->status);
+  ASSERT_TRUE(response->result);
+  ASSERT_EQ(1u, response->result->get_records().size());
+  EXPECT_EQ("foobar", response->result->get_records().front()->fields.at(0)->
+      get_string_value());
+}
+
+TEST_F(BatAdsClientMojoBridgeTest,
+    FailDirectDBTransactionInFlightWhenDatabaseIsReset) {
+  // Arrange
+  ads::DBCommandResponsePtr response;
+
+  // Act
+  base::RunLoop run_loop;
+  RunDBTransaction(CreateTransaction(), &response, run_loop.QuitClosure());
+  ResetDatabase();
+  run_loop.Run();
+
+  // Assert
+  ASSERT_TRUE(response);
+  EXPECT_EQ(ads::DBCommandResponse::Status::RESPONSE_ERROR, response->status);
+}
+
+TEST_F(BatAdsClientMojoBridgeTest,
+    FailDirectDBTransactionAfterDatabaseIsReset) {
+  // Arrange
+  ResetDatabase();
+  task_environment_.RunUntilIdle();
+
+  ads::DBCommandResponsePtr response;
+
+  // Act
+  base::RunLoop run_loop;
+  RunDBTransaction(CreateTransaction(), &response, run_loop.QuitClosure());
+  run_loop.Run();
+
+  // Assert
+  ASSERT_TRUE(response);
+  EXPECT_EQ(ads::DBCommandResponse::Status::RESPONSE_ERROR, response->status);
+}
+
+}  // namespace bat_ads
@@ -35,9 +35,10 @@ ads::CategoryContent::OptAction ToAdsOptAction(
 }  // namespace
 
 BatAdsImpl::BatAdsImpl(
-    mojo::PendingAssociatedRemote<mojom::BatAdsClient> client_info) :
+    mojo::PendingAssociatedRemote<mojom::BatAdsClient> client_info,
+    mojo::PendingRemote<mojom::BatAdsDatabase> bat_ads_database) :
     bat_ads_client_mojo_proxy_(new BatAdsClientMojoBridge(
-        std::move(client_info))),
+        std::move(client_info), std::move(bat_ads_database))),
     ads_(ads::Ads::CreateInstance(bat_ads_client_mojo_proxy_.get())) {
 }
 
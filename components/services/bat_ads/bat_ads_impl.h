@@ -14,6 +14,7 @@
 #include "base/memory/weak_ptr.h"
 #include "brave/components/services/bat_ads/public/interfaces/bat_ads.mojom.h"
 #include "mojo/public/cpp/bindings/interface_request.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
 #include "bat/ads/ads.h"
 #include "bat/ads/statement_info.h"
 
@@ -29,8 +30,9 @@ class BatAdsImpl :
     public mojom::BatAds,
     public base::SupportsWeakPtr<BatAdsImpl> {
  public:
-  explicit BatAdsImpl(
-      mojo::PendingAssociatedRemote<mojom::BatAdsClient> client_info);
+  BatAdsImpl(
+      mojo::PendingAssociatedRemote<mojom::BatAdsClient> client_info,
+      mojo::PendingRemote<mojom::BatAdsDatabase> bat_ads_database);
   ~BatAdsImpl() override;
 
   BatAdsImpl(const BatAdsImpl&) = delete;
@@ -23,10 +23,11 @@ BatAdsServiceImpl::~BatAdsServiceImpl() {}
 void BatAdsServiceImpl::Create(
     mojo::PendingAssociatedRemote<mojom::BatAdsClient> client_info,
     mojo::PendingAssociatedReceiver<mojom::BatAds> bat_ads,
+    mojo::PendingRemote<mojom::BatAdsDatabase> bat_ads_database,
     CreateCallback callback) {
 
-  receivers_.Add(std::make_unique<BatAdsImpl>(std::move(client_info)),
-                 std::move(bat_ads));
+  receivers_.Add(std::make_unique<BatAdsImpl>(std::move(client_info),
+      std::move(bat_ads_database)), std::move(bat_ads));
   is_initialized_ = true;
   std::move(callback).Run();
 }
@@ -14,6 +14,7 @@
 #include "brave/components/services/bat_ads/public/interfaces/bat_ads.mojom.h"
 #include "mojo/public/cpp/bindings/pending_associated_receiver.h"
 #include "mojo/public/cpp/bindings/pending_associated_remote.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
 #include "mojo/public/cpp/bindings/unique_associated_receiver_set.h"
 #include "services/service_manager/public/cpp/service_context_ref.h"
 
@@ -33,6 +34,7 @@ class BatAdsServiceImpl : public mojom::BatAdsService {
   void Create(
       mojo::PendingAssociatedRemote<mojom::BatAdsClient> client_info,
       mojo::PendingAssociatedReceiver<mojom::BatAds> bat_ads,
+      mojo::PendingRemote<mojom::BatAdsDatabase> bat_ads_database,
       CreateCallback callback) override;
 
   void SetEnvironment(
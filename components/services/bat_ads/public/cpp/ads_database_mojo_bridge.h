@@ -0,0 +1,49 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_SERVICES_BAT_ADS_PUBLIC_CPP_ADS_DATABASE_MOJO_BRIDGE_H_
+#define BRAVE_COMPONENTS_SERVICES_BAT_ADS_PUBLIC_CPP_ADS_DATABASE_MOJO_BRIDGE_H_
+
+#include "base/sequence_checker.h"
+#include "bat/ads/database.h"
+#include "brave/components/services/bat_ads/public/interfaces/bat_ads.mojom.h"
+#include "mojo/public/cpp/bindings/pending_receiver.h"
+#include "mojo/public/cpp/bindings/receiver.h"
+
+namespace bat_ads {
+
+// Runs database transactions from bat ads on the sequence of |database|, so
+// that they don't have to go through the browser UI thread. May be created on
+// any sequence, but must be bound and deleted on the sequence of |database|,
+// and deleted before it.
+class AdsDatabaseMojoBridge : public mojom::BatAdsDatabase {
+ public:
+  explicit AdsDatabaseMojoBridge(
+      ads::Database* database);
+
+  ~AdsDatabaseMojoBridge() override;
+
+  AdsDatabaseMojoBridge(const AdsDatabaseMojoBridge&) = delete;
+  AdsDatabaseMojoBridge& operator=(const AdsDatabaseMojoBridge&) = delete;
+
+  void Bind(
+      mojo::PendingReceiver<mojom::BatAdsDatabase> receiver);
+
+  // Overridden from BatAdsDatabase:
+  void RunTransaction(
+      ads::DBTransactionPtr transaction,
+      RunTransactionCallback callback) override;
+
+ private:
+  ads::Database* database_;  // NOT OWNED
+
+  mojo::Receiver<mojom::BatAdsDatabase> receiver_{this};
+
+  SEQUENCE_CHECKER(sequence_checker_);
+};
+
+}  // namespace bat_ads
+
+#endif  // BRAVE_COMPONENTS_SERVICES_BAT_ADS_PUBLIC_CPP_ADS_DATABASE_MOJO_BRIDGE_H_
@@ -11,13 +11,42 @@
 #include <vector>
 
 #include "base/logging.h"
+#include "base/metrics/histogram_functions.h"
+#include "base/time/time.h"
 #include "brave/base/containers/utils.h"
 
 namespace bat_ledger {
 
+namespace {
+
+// Time from running a database transaction until its response arrives, for
+// transactions run directly on the browser database sequence and for those
+// run through the browser UI thread
+const char kDirectDBTransactionHistogramName[] =
+    "Brave.Rewards.DBTransactionTime.Direct";
+const char kClientDBTransactionHistogramName[] =
+    "Brave.Rewards.DBTransactionTime.BrowserUIThread";
+
+ledger::DBCommandResponsePtr CreateDBErrorResponse() {
+  auto response = ledger::DBCommandResponse::New();
+  response->status = ledger::DBCommandResponse::Status::RESPONSE_ERROR;
+  return response;
+}
+
+}  // namespace
+
 BatLedgerClientMojoBridge::BatLedgerClientMojoBridge(
-      mojo::PendingAssociatedRemote<mojom::BatLedgerClient> client_info) {
+      mojo::PendingAssociatedRemote<mojom::BatLedgerClient> client_info,
+      mojo::PendingRemote<mojom::BatLedgerDatabase> bat_ledger_database) {
   bat_ledger_client_.Bind(std::move(client_info));
+
+  if (bat_ledger_database) {
+    bat_ledger_database_.Bind(std::move(bat_ledger_database));
+    bat_ledger_database_.set_disconnect_handler(
+        base::BindOnce(
+            &BatLedgerClientMojoBridge::OnBatLedgerDatabaseDisconnected,
+            base::Unretained(this)));
+  }
 }
 
 BatLedgerClientMojoBridge::~BatLedgerClientMojoBridge() = default;
@@ -353,16 +382,72 @@ void BatLedgerClientMojoBridge::ReconcileStampReset() {
 
 void OnRunDBTransaction(
     const ledger::RunDBTransactionCallback& callback,
+    const char* histogram_name,
+    const base::TimeTicks start_time,
     ledger::DBCommandResponsePtr response) {
+  base::UmaHistogramTimes(histogram_name, base::TimeTicks::Now() - start_time);
+
   callback(std::move(response));
 }
 
 void BatLedgerClientMojoBridge::RunDBTransaction(
     ledger::DBTransactionPtr transaction,
     ledger::RunDBTransactionCallback callback) {
+  const base::TimeTicks start_time = base::TimeTicks::Now();
+
+  if (bat_ledger_database_.is_bound()) {
+    if (!bat_ledger_database_.is_connected()) {
+      callback(CreateDBErrorResponse());
+      return;
+    }
+
+    const uint64_t transaction_id = next_direct_db_transaction_id_++;
+    direct_db_transactions_[transaction_id] = callback;
+
+    // Unretained is safe as |bat_ledger_database_| does not run callbacks
+    // after it is destroyed
+    bat_ledger_database_->RunTransaction(
+        std::move(transaction),
+        base::BindOnce(&BatLedgerClientMojoBridge::OnRunDirectDBTransaction,
+            base::Unretained(this),
+            transaction_id,
+            start_time));
+    return;
+  }
+
   bat_ledger_client_->RunDBTransaction(
       std::move(transaction),
-      base::BindOnce(&OnRunDBTransaction, std::move(callback)));
+      base::BindOnce(&OnRunDBTransaction,
+          std::move(callback),
+          kClientDBTransactionHistogramName,
+          start_time));
+}
+
+void BatLedgerClientMojoBridge::OnRunDirectDBTransaction(
+    const uint64_t transaction_id,
+    const base::TimeTicks start_time,
+    ledger::DBCommandResponsePtr response) {
+  const auto iter = direct_db_transactions_.find(transaction_id);
+  DCHECK(iter != direct_db_transactions_.end());
+  const ledger::RunDBTransactionCallback callback = iter->second;
+  direct_db_transactions_.erase(iter);
+
+  OnRunDBTransaction(
+      callback,
+      kDirectDBTransactionHistogramName,
+      start_time,
+      std::move(response));
+}
+
+void BatLedgerClientMojoBridge::OnBatLedgerDatabaseDisconnected() {
+  // Transactions in flight when the browser resets the database are dropped
+  // without a response, so fail them as if the database was not there
+  std::map<uint64_t, ledger::RunDBTransactionCallback> transactions;
+  transactions.swap(direct_db_transactions_);
+
+  for (const auto& transaction : transactions) {
+    transaction.second(CreateDBErrorResponse());
+  }
 }
 
 void OnGetCreateScript(
@@ -6,16 +6,21 @@
 #ifndef BRAVE_COMPONENTS_SERVICES_BAT_LEDGER_BAT_LEDGER_CLIENT_MOJO_BRIDGE_H_
 #define BRAVE_COMPONENTS_SERVICES_BAT_LEDGER_BAT_LEDGER_CLIENT_MOJO_BRIDGE_H_
 
+#include <stdint.h>
+
 #include <map>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "bat/ledger/ledger_client.h"
 #include "brave/components/services/bat_ledger/public/interfaces/bat_ledger.mojom.h"
 #include "mojo/public/cpp/bindings/associated_remote.h"
 #include "mojo/public/cpp/bindings/pending_associated_remote.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
+#include "mojo/public/cpp/bindings/remote.h"
 
 namespace bat_ledger {
 
@@ -23,8 +28,11 @@ class BatLedgerClientMojoBridge :
     public ledger::LedgerClient,
     public base::SupportsWeakPtr<BatLedgerClientMojoBridge>{
  public:
+  // Database transactions are run through |bat_ledger_database| if it is
+  // valid, otherwise through |client_info|
   BatLedgerClientMojoBridge(
-      mojo::PendingAssociatedRemote<mojom::BatLedgerClient> client_info);
+      mojo::PendingAssociatedRemote<mojom::BatLedgerClient> client_info,
+      mojo::PendingRemote<mojom::BatLedgerDatabase> bat_ledger_database);
   ~BatLedgerClientMojoBridge() override;
 
   BatLedgerClientMojoBridge(const BatLedgerClientMojoBridge&) = delete;
@@ -140,7 +148,21 @@ class BatLedgerClientMojoBridge :
  private:
   bool Connected() const;
 
+  void OnRunDirectDBTransaction(
+      const uint64_t transaction_id,
+      const base::TimeTicks start_time,
+      ledger::DBCommandResponsePtr response);
+
+  void OnBatLedgerDatabaseDisconnected();
+
   mojo::AssociatedRemote<mojom::BatLedgerClient> bat_ledger_client_;
+  mojo::Remote<mojom::BatLedgerDatabase> bat_ledger_database_;
+
+  // Callbacks of transactions sent to |bat_ledger_database_| which have not
+  // been answered yet, so that they can fail if the browser resets the
+  // database
+  std::map<uint64_t, ledger::RunDBTransactionCallback> direct_db_transactions_;
+  uint64_t next_direct_db_transaction_id_ = 0;
 };
 
 }  // namespace bat_ledger
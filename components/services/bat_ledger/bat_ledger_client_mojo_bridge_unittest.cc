@@ -0,0 +1,166 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/services/bat_ledger/bat_ledger_client_mojo_bridge.h"
+
+#include <memory>
+#include <utility>
+
+#include "base/files/scoped_temp_dir.h"
+#include "base/macros.h"
+#include "base/run_loop.h"
+#include "base/test/task_environment.h"
+#include "bat/ledger/ledger_database.h"
+#include "brave/components/services/bat_ledger/public/cpp/ledger_database_mojo_bridge.h"
+#include "mojo/public/cpp/bindings/pending_associated_remote.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=BatLedgerClientMojoBridgeTest.*
+
+namespace bat_ledger {
+
+namespace {
+
+ledger::DBTransactionPtr CreateTransaction() {
+  auto transaction = ledger::DBTransaction::New();
+  transaction->version = 1;
+  transaction->compatible_version = 1;
+
+  auto initialize_command = ledger::DBCommand::New();
+  initialize_command->type = ledger::DBCommand::Type::INITIALIZE;
+  transaction->commands.push_back(std::move(initialize_command));
+
+  auto create_command = ledger::DBCommand::New();
+  create_command->type = ledger::DBCommand::Type::EXECUTE;
+  create_command->command = "CREATE TABLE IF NOT EXISTS test (value TEXT)";
+  transaction->commands.push_back(std::move(create_command));
+
+  auto insert_command = ledger::DBCommand::New();
+  insert_command->type = ledger::DBCommand::Type::EXECUTE;
+  insert_command->command = "INSERT INTO test (value) VALUES ('foobar')";
+  transaction->commands.push_back(std::move(insert_command));
+
+  auto read_command = ledger::DBCommand::New();
+  read_command->type = ledger::DBCommand::Type::READ;
+  read_command->command = "SELECT value FROM test";
+  read_command->record_bindings = {
+    ledger::DBCommand::RecordBindingType::STRING_TYPE
+  };
+  transaction->commands.push_back(std::move(read_command));
+
+  return transaction;
+}
+
+}  // namespace
+
+class BatLedgerClientMojoBridgeTest : public ::testing::Test {
+ protected:
+  BatLedgerClientMojoBridgeTest() = default;
+
+  ~BatLedgerClientMojoBridgeTest() override = default;
+
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+
+    ledger_database_.reset(ledger::LedgerDatabase::CreateInstance(
+        temp_dir_.GetPath().AppendASCII("publisher_info_db")));
+
+    // The database is bound to the test sequence, which stands in for the
+    // browser file task runner used when direct database access is enabled
+    mojo::PendingRemote<mojom::BatLedgerDatabase> bat_ledger_database;
+    ledger_database_bridge_ = std::make_unique<LedgerDatabaseMojoBridge>(
+        ledger_database_.get());
+    ledger_database_bridge_->Bind(
+        bat_ledger_database.InitWithNewPipeAndPassReceiver());
+
+    // Transactions are not run through the client, so it is left unbound
+    mojo::PendingAssociatedRemote<mojom::BatLedgerClient> bat_ledger_client;
+    ignore_result(bat_ledger_client.InitWithNewEndpointAndPassReceiver());
+
+    client_mojo_bridge_ = std::make_unique<BatLedgerClientMojoBridge>(
+        std::move(bat_ledger_client),
+        std::move(bat_ledger_database));
+  }
+
+  void RunDBTransaction(
+      ledger::DBTransactionPtr transaction,
+      ledger::DBCommandResponsePtr* response,
+      base::RepeatingClosure quit_closure) {
+    client_mojo_bridge_->RunDBTransaction(
+        std::move(transaction),
+        [response, quit_closure](
+            ledger::DBCommandResponsePtr command_response) {
+          *response = std::move(command_response);
+          quit_closure.Run();
+        });
+  }
+
+  void ResetLedgerDatabase() {
+    // Same order as |RewardsServiceImpl::ResetLedgerDatabase|
+    ledger_database_bridge_.reset();
+    ledger_database_.reset();
+  }
+
+  base::test::TaskEnvironment task_environment_;
+
+  base::ScopedTempDir temp_dir_;
+
+  std::unique_ptr<ledger::LedgerDatabase> ledger_database_;
+  std::unique_ptr<LedgerDatabaseMojoBridge> ledger_database_bridge_;
+
+  std::unique_ptr<BatLedgerClientMojoBridge> client_mojo_bridge_;
+};
+
+TEST_F(BatLedgerClientMojoBridgeTest, RunDirectDBTransaction) {
+  ledger::DBCommandResponsePtr response;
+
+  base::RunLoop run_loop;
+  RunDBTransaction(CreateTransaction(), &response, run_loop.QuitClosure());
+  run_loop.Run();
+
+  ASSERT_TRUE(response);
+  EXPECT_EQ(ledger::DBCommandResponse::Status::RESPONSE_OK, response->status);
+  ASSERT_TRUE(response->result);
+  ASSERT_EQ(1u, response->result->get_records().size());
+  EXPECT_EQ(
+      "foobar",
+      response->result->get_records().front()->fields.at(0)->
+          get_string_value());
+}
+
+TEST_F(BatLedgerClientMojoBridgeTest,
+    FailDirectDBTransactionInFlightWhenDatabaseIsReset) {
+  ledger::DBCommandResponsePtr response;
+
+  base::RunLoop run_loop;
+  RunDBTransaction(CreateTransaction(), &response, run_loop.QuitClosure());
+  ResetLedgerDatabase();
+  run_loop.Run();
+
+  ASSERT_TRUE(response);
+  EXPECT_EQ(
+      ledger::DBCommandResponse::Status::RESPONSE_ERROR,
+      response->status);
+}
+
+TEST_F(BatLedgerClientMojoBridgeTest,
+    FailDirectDBTransactionAfterDatabaseIsReset) {
+  ResetLedgerDatabase();
+  task_environment_.RunUntilIdle();
+
+  ledger::DBCommandResponsePtr response;
+
+  base::RunLoop run_loop;
+  RunDBTransaction(CreateTransaction(), &response, run_loop.QuitClosure());
+  run_loop.Run();
+
+  ASSERT_TRUE(response);
+  EXPECT_EQ(
+      ledger::DBCommandResponse::Status::RESPONSE_ERROR,
+      response->status);
+}
+
+}  // namespace bat_ledger
@@ -23,9 +23,11 @@ using std::placeholders::_3;
 namespace bat_ledger {
 
 BatLedgerImpl::BatLedgerImpl(
-    mojo::PendingAssociatedRemote<mojom::BatLedgerClient> client_info)
+    mojo::PendingAssociatedRemote<mojom::BatLedgerClient> client_info,
+    mojo::PendingRemote<mojom::BatLedgerDatabase> bat_ledger_database)
   : bat_ledger_client_mojo_bridge_(
-      new BatLedgerClientMojoBridge(std::move(client_info))),
+      new BatLedgerClientMojoBridge(std::move(client_info),
+          std::move(bat_ledger_database))),
     ledger_(
       ledger::Ledger::CreateInstance(bat_ledger_client_mojo_bridge_.get())) {
 }
@@ -29,9 +29,11 @@ BatLedgerServiceImpl::~BatLedgerServiceImpl() = default;
 void BatLedgerServiceImpl::Create(
     mojo::PendingAssociatedRemote<mojom::BatLedgerClient> client_info,
     mojo::PendingAssociatedReceiver<mojom::BatLedger> bat_ledger,
+    mojo::PendingRemote<mojom::BatLedgerDatabase> bat_ledger_database,
     CreateCallback callback) {
   receivers_.Add(
-      std::make_unique<BatLedgerImpl>(std::move(client_info)),
+      std::make_unique<BatLedgerImpl>(std::move(client_info),
+          std::move(bat_ledger_database)),
       std::move(bat_ledger));
   initialized_ = true;
   std::move(callback).Run();
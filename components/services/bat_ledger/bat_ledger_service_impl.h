@@ -12,6 +12,7 @@
 #include "brave/components/services/bat_ledger/public/interfaces/bat_ledger.mojom.h"
 #include "mojo/public/cpp/bindings/pending_associated_receiver.h"
 #include "mojo/public/cpp/bindings/pending_associated_remote.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
 #include "mojo/public/cpp/bindings/unique_associated_receiver_set.h"
 #include "services/service_manager/public/cpp/service_context_ref.h"
 
@@ -31,6 +32,7 @@ class BatLedgerServiceImpl : public mojom::BatLedgerService {
   void Create(
       mojo::PendingAssociatedRemote<mojom::BatLedgerClient> client_info,
       mojo::PendingAssociatedReceiver<mojom::BatLedger> bat_ledger,
+      mojo::PendingRemote<mojom::BatLedgerDatabase> bat_ledger_database,
       CreateCallback callback) override;
 
   void SetEnvironment(ledger::Environment environment) override;
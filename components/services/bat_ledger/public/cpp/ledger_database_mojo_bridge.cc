@@ -0,0 +1,42 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/services/bat_ledger/public/cpp/ledger_database_mojo_bridge.h"
+
+#include <utility>
+
+#include "base/logging.h"
+
+namespace bat_ledger {
+
+LedgerDatabaseMojoBridge::LedgerDatabaseMojoBridge(
+    ledger::LedgerDatabase* database)
+    : database_(database) {
+  DCHECK(database_);
+  DETACH_FROM_SEQUENCE(sequence_checker_);
+}
+
+LedgerDatabaseMojoBridge::~LedgerDatabaseMojoBridge() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+}
+
+void LedgerDatabaseMojoBridge::Bind(
+    mojo::PendingReceiver<mojom::BatLedgerDatabase> receiver) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  receiver_.Bind(std::move(receiver));
+}
+
+void LedgerDatabaseMojoBridge::RunTransaction(
+    ledger::DBTransactionPtr transaction,
+    RunTransactionCallback callback) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  auto response = ledger::DBCommandResponse::New();
+  database_->RunTransaction(std::move(transaction), response.get());
+
+  std::move(callback).Run(std::move(response));
+}
+
+}  // namespace bat_ledger
@@ -0,0 +1,46 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_SERVICES_BAT_LEDGER_PUBLIC_CPP_LEDGER_DATABASE_MOJO_BRIDGE_H_
+#define BRAVE_COMPONENTS_SERVICES_BAT_LEDGER_PUBLIC_CPP_LEDGER_DATABASE_MOJO_BRIDGE_H_
+
+#include "base/sequence_checker.h"
+#include "bat/ledger/ledger_database.h"
+#include "brave/components/services/bat_ledger/public/interfaces/bat_ledger.mojom.h"
+#include "mojo/public/cpp/bindings/pending_receiver.h"
+#include "mojo/public/cpp/bindings/receiver.h"
+
+namespace bat_ledger {
+
+// Runs database transactions from bat ledger on the sequence of |database|,
+// so that they don't have to go through the browser UI thread. May be created
+// on any sequence, but must be bound and deleted on the sequence of
+// |database|, and deleted before it.
+class LedgerDatabaseMojoBridge : public mojom::BatLedgerDatabase {
+ public:
+  explicit LedgerDatabaseMojoBridge(ledger::LedgerDatabase* database);
+  ~LedgerDatabaseMojoBridge() override;
+
+  LedgerDatabaseMojoBridge(const LedgerDatabaseMojoBridge&) = delete;
+  LedgerDatabaseMojoBridge& operator=(const LedgerDatabaseMojoBridge&) = delete;
+
+  void Bind(mojo::PendingReceiver<mojom::BatLedgerDatabase> receiver);
+
+  // bat_ledger::mojom::BatLedgerDatabase
+  void RunTransaction(
+      ledger::DBTransactionPtr transaction,
+      RunTransactionCallback callback) override;
+
+ private:
+  ledger::LedgerDatabase* database_;  // NOT OWNED
+
+  mojo::Receiver<mojom::BatLedgerDatabase> receiver_{this};
+
+  SEQUENCE_CHECKER(sequence_checker_);
+};
+
+}  // namespace bat_ledger
+
+#endif  // BRAVE_COMPONENTS_SERVICES_BAT_LEDGER_PUBLIC_CPP_LEDGER_DATABASE_MOJO_BRIDGE_H_
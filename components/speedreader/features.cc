@@ -19,4 +19,7 @@ const base::Feature kSpeedreaderFeature {
 #endif
 };
 
+const base::Feature kSpeedreaderStreamingFeature{
+    "SpeedreaderStreaming", base::FEATURE_DISABLED_BY_DEFAULT};
+
 }  // namespace speedreader
@@ -12,6 +12,9 @@ struct Feature;
 
 namespace speedreader {
 extern const base::Feature kSpeedreaderFeature;
+// Distills response bodies as they arrive instead of after the whole body
+// has been buffered.
+extern const base::Feature kSpeedreaderStreamingFeature;
 }  // namespace speedreader
 
 #endif  // BRAVE_COMPONENTS_SPEEDREADER_FEATURES_H_
@@ -0,0 +1,147 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/speedreader/speedreader_streaming_distiller.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/logging.h"
+#include "brave/components/speedreader/rust/ffi/speedreader.h"
+
+namespace speedreader {
+
+constexpr size_t StreamingDistiller::kMinDistilledSize;
+
+StreamingDistiller::StreamingDistiller(std::string stylesheet,
+                                       OutputCallback output_callback,
+                                       DoneCallback done_callback)
+    : stylesheet_(std::move(stylesheet)),
+      output_callback_(std::move(output_callback)),
+      done_callback_(std::move(done_callback)) {
+  DETACH_FROM_SEQUENCE(sequence_checker_);
+}
+
+StreamingDistiller::~StreamingDistiller() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+}
+
+// static
+void StreamingDistiller::OnRewriterOutput(const char* chunk,
+                                          size_t chunk_len,
+                                          void* distiller) {
+  static_cast<StreamingDistiller*>(distiller)->AppendOutput(chunk, chunk_len);
+}
+
+void StreamingDistiller::SetRewriter(std::unique_ptr<Rewriter> rewriter) {
+  DCHECK(!rewriter_);
+  rewriter_ = std::move(rewriter);
+}
+
+void StreamingDistiller::Write(std::string chunk) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  switch (state_) {
+    case State::kPassingThrough:
+      output_callback_.Run(std::move(chunk));
+      return;
+    case State::kDone:
+      return;
+    case State::kUndecided:
+      original_body_.append(chunk);
+      peak_buffered_bytes_ =
+          std::max(peak_buffered_bytes_,
+                   original_body_.size() + pending_output_.size());
+      break;
+    case State::kDistilling:
+      break;
+  }
+
+  DCHECK(rewriter_);
+  if (rewriter_->Write(chunk.data(), chunk.size()) == 0)
+    return;
+
+  if (state_ == State::kUndecided) {
+    PassThrough();
+    return;
+  }
+  // Part of the distilled page has already been sent, so the best that can
+  // be done is to stop.
+  VLOG(2) << __func__ << " rewriter failed after output was sent";
+  Finish(true);
+}
+
+void StreamingDistiller::End() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  switch (state_) {
+    case State::kPassingThrough:
+      Finish(false);
+      return;
+    case State::kDone:
+      return;
+    case State::kUndecided:
+    case State::kDistilling:
+      break;
+  }
+
+  // Flushes the remaining output through AppendOutput(), which may commit.
+  DCHECK(rewriter_);
+  rewriter_->End();
+  if (state_ == State::kUndecided) {
+    PassThrough();
+    Finish(false);
+    return;
+  }
+  Finish(true);
+}
+
+void StreamingDistiller::AppendOutput(const char* chunk, size_t chunk_len) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  switch (state_) {
+    case State::kDistilling:
+      output_callback_.Run(std::string(chunk, chunk_len));
+      return;
+    case State::kUndecided:
+      pending_output_.append(chunk, chunk_len);
+      peak_buffered_bytes_ =
+          std::max(peak_buffered_bytes_,
+                   original_body_.size() + pending_output_.size());
+      if (pending_output_.size() >= kMinDistilledSize)
+        CommitToDistilled();
+      return;
+    case State::kPassingThrough:
+    case State::kDone:
+      return;
+  }
+}
+
+void StreamingDistiller::CommitToDistilled() {
+  DCHECK_EQ(State::kUndecided, state_);
+  state_ = State::kDistilling;
+  original_body_.clear();
+  original_body_.shrink_to_fit();
+  std::string output = std::move(stylesheet_);
+  output.append(pending_output_);
+  pending_output_.clear();
+  pending_output_.shrink_to_fit();
+  output_callback_.Run(std::move(output));
+}
+
+void StreamingDistiller::PassThrough() {
+  DCHECK_EQ(State::kUndecided, state_);
+  state_ = State::kPassingThrough;
+  pending_output_.clear();
+  pending_output_.shrink_to_fit();
+  if (!original_body_.empty())
+    output_callback_.Run(std::move(original_body_));
+  original_body_.clear();
+}
+
+void StreamingDistiller::Finish(bool distilled) {
+  state_ = State::kDone;
+  rewriter_.reset();
+  std::move(done_callback_).Run(distilled, peak_buffered_bytes_);
+}
+
+}  // namespace speedreader
@@ -0,0 +1,88 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_SPEEDREADER_SPEEDREADER_STREAMING_DISTILLER_H_
+#define BRAVE_COMPONENTS_SPEEDREADER_SPEEDREADER_STREAMING_DISTILLER_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+
+#include "base/callback.h"
+#include "base/sequence_checker.h"
+
+namespace speedreader {
+
+class Rewriter;
+
+// Feeds a response body to a single long-lived Rewriter chunk by chunk and
+// forwards distilled output as soon as the rewriter produces it. Lives on a
+// dedicated sequence so the loader's thread never runs the rewriter.
+//
+// Output is held back until the rewriter has produced kMinDistilledSize
+// bytes, which is how the buffered path decides that a page was distilled.
+// Until then the original body is kept as well, so that it can be passed
+// through untouched if the rewriter fails or produces too little.
+class StreamingDistiller {
+ public:
+  // Called with each chunk of the body that should be sent to the client.
+  using OutputCallback = base::RepeatingCallback<void(std::string output)>;
+  // Called once all output has been reported. |peak_buffered_bytes| is the
+  // most input and output held at once while deciding whether to distill.
+  using DoneCallback =
+      base::OnceCallback<void(bool distilled, size_t peak_buffered_bytes)>;
+
+  static constexpr size_t kMinDistilledSize = 1024;
+
+  StreamingDistiller(std::string stylesheet,
+                     OutputCallback output_callback,
+                     DoneCallback done_callback);
+  ~StreamingDistiller();
+
+  StreamingDistiller(const StreamingDistiller&) = delete;
+  StreamingDistiller& operator=(const StreamingDistiller&) = delete;
+
+  // The output sink to create the rewriter with, using the distiller as the
+  // sink's user data.
+  static void OnRewriterOutput(const char* chunk,
+                               size_t chunk_len,
+                               void* distiller);
+
+  // Must be called before the first Write(). May be called from any
+  // sequence.
+  void SetRewriter(std::unique_ptr<Rewriter> rewriter);
+
+  void Write(std::string chunk);
+  // Signals that the whole body has been written.
+  void End();
+
+ private:
+  enum class State { kUndecided, kDistilling, kPassingThrough, kDone };
+
+  void AppendOutput(const char* chunk, size_t chunk_len);
+  // Starts forwarding rewriter output and drops the original body.
+  void CommitToDistilled();
+  // Forwards the original body and all further input unchanged.
+  void PassThrough();
+  void Finish(bool distilled);
+
+  State state_ = State::kUndecided;
+  std::unique_ptr<Rewriter> rewriter_;
+  std::string stylesheet_;
+  // Only kept until a decision is made.
+  std::string original_body_;
+  std::string pending_output_;
+  size_t peak_buffered_bytes_ = 0;
+
+  OutputCallback output_callback_;
+  DoneCallback done_callback_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+};
+
+}  // namespace speedreader
+
+#endif  // BRAVE_COMPONENTS_SPEEDREADER_SPEEDREADER_STREAMING_DISTILLER_H_
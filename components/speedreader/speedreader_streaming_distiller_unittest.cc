@@ -0,0 +1,204 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/speedreader/speedreader_streaming_distiller.h"
+
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include "base/bind.h"
+#include "base/strings/stringprintf.h"
+#include "brave/components/speedreader/rust/ffi/speedreader.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace speedreader {
+
+namespace {
+
+constexpr char kTestConfig[] = R"(
+[
+    {
+        "domain": "example.com",
+        "url_rules": [
+            "||example.com/*/article/"
+        ],
+        "declarative_rewrite": {
+            "main_content": [
+                ".article-title",
+                ".article-body"
+            ],
+            "main_content_cleanup": [
+                ".hidden"
+            ],
+            "delazify": true,
+            "fix_embeds": false,
+            "content_script": null,
+            "preprocess": []
+        }
+    }
+]
+)";
+
+constexpr char kArticleURL[] =
+    "https://example.com/news/article/topic/index.html";
+constexpr char kStylesheet[] = "<style>body { color: #000; }</style>";
+constexpr size_t kChunkSize = 32768;
+
+std::string MakeArticle(int paragraphs) {
+  std::string body =
+      "<html><body><div class=\"nav\">navigation</div>"
+      "<div class=\"article-title\">Title</div><div class=\"article-body\">";
+  for (int i = 0; i < paragraphs; ++i) {
+    body += base::StringPrintf(
+        "<p>Paragraph %d of an article that is long enough to be worth "
+        "distilling.</p><div class=\"hidden\">ad %d</div>",
+        i, i);
+  }
+  body += "</div></body></html>";
+  return body;
+}
+
+// What SpeedReaderURLLoader produces without streaming.
+std::string DistillBuffered(SpeedReader* speedreader, const std::string& body) {
+  std::unique_ptr<Rewriter> rewriter = speedreader->MakeRewriter(kArticleURL);
+  if (rewriter->Write(body.c_str(), body.length()) != 0)
+    return body;
+  rewriter->End();
+  const std::string& transformed = rewriter->GetOutput();
+  if (transformed.length() < StreamingDistiller::kMinDistilledSize)
+    return body;
+  return kStylesheet + transformed;
+}
+
+class StreamingDistillerTest : public testing::Test {
+ public:
+  void SetUp() override {
+    ASSERT_TRUE(speedreader_.deserialize(kTestConfig, strlen(kTestConfig)));
+  }
+
+  // Runs |body| through a StreamingDistiller in loader-sized chunks.
+  void DistillStreaming(const std::string& body) {
+    output_.clear();
+    done_ = false;
+    StreamingDistiller distiller(
+        kStylesheet,
+        base::BindRepeating(&StreamingDistillerTest::OnOutput,
+                            base::Unretained(this)),
+        base::BindOnce(&StreamingDistillerTest::OnDone,
+                       base::Unretained(this)));
+    distiller.SetRewriter(speedreader_.MakeRewriter(
+        kArticleURL, RewriterType::RewriterUnknown,
+        &StreamingDistiller::OnRewriterOutput, &distiller));
+    for (size_t offset = 0; offset < body.size(); offset += kChunkSize)
+      distiller.Write(body.substr(offset, kChunkSize));
+    distiller.End();
+    ASSERT_TRUE(done_);
+  }
+
+ protected:
+  void OnOutput(std::string output) {
+    ASSERT_FALSE(done_);
+    output_ += output;
+  }
+
+  void OnDone(bool distilled, size_t peak_buffered_bytes) {
+    ASSERT_FALSE(done_);
+    done_ = true;
+    distilled_ = distilled;
+    peak_buffered_bytes_ = peak_buffered_bytes;
+  }
+
+  SpeedReader speedreader_;
+  std::string output_;
+  bool done_ = false;
+  bool distilled_ = false;
+  size_t peak_buffered_bytes_ = 0;
+};
+
+}  // namespace
+
+TEST_F(StreamingDistillerTest, MatchesBufferedDistilling) {
+  const std::string body = MakeArticle(2000);
+  DistillStreaming(body);
+  EXPECT_TRUE(distilled_);
+  EXPECT_EQ(DistillBuffered(&speedreader_, body), output_);
+  EXPECT_EQ(0u, output_.find(kStylesheet));
+}
+
+TEST_F(StreamingDistillerTest, PassesThroughShortOutput) {
+  const std::string body = MakeArticle(1);
+  DistillStreaming(body);
+  EXPECT_FALSE(distilled_);
+  EXPECT_EQ(body, output_);
+  EXPECT_EQ(DistillBuffered(&speedreader_, body), output_);
+}
+
+TEST_F(StreamingDistillerTest, PassesThroughRewriterErrors) {
+  const std::string body =
+      "<select><div><style><div></div></style></div></select>";
+  DistillStreaming(body);
+  EXPECT_FALSE(distilled_);
+  EXPECT_EQ(body, output_);
+}
+
+// Once part of the distilled page has been sent, a rewriter error ends the
+// output, and the rest of the body is ignored.
+TEST_F(StreamingDistillerTest, StopsOnRewriterErrorAfterOutput) {
+  std::string article = MakeArticle(2000);
+  // Drop the closing tags, so that the broken markup ends up in the article.
+  article.resize(article.size() - strlen("</div></body></html>"));
+  const std::string broken_markup =
+      "<select><div><style><div></div></style></div></select>";
+
+  StreamingDistiller distiller(
+      kStylesheet,
+      base::BindRepeating(&StreamingDistillerTest::OnOutput,
+                          base::Unretained(this)),
+      base::BindOnce(&StreamingDistillerTest::OnDone,
+                     base::Unretained(this)));
+  distiller.SetRewriter(speedreader_.MakeRewriter(
+      kArticleURL, RewriterType::RewriterUnknown,
+      &StreamingDistiller::OnRewriterOutput, &distiller));
+  for (size_t offset = 0; offset < article.size(); offset += kChunkSize)
+    distiller.Write(article.substr(offset, kChunkSize));
+  // The distiller has committed to the distilled page.
+  ASSERT_FALSE(output_.empty());
+  EXPECT_EQ(0u, output_.find(kStylesheet));
+  ASSERT_FALSE(done_);
+
+  distiller.Write(broken_markup);
+  EXPECT_TRUE(done_);
+  EXPECT_TRUE(distilled_);
+
+  // Later input, as a loader that keeps reading the body would write it, is
+  // ignored. OnOutput() and OnDone() fail if they run again.
+  const std::string output = output_;
+  distiller.Write(MakeArticle(10));
+  distiller.End();
+  EXPECT_EQ(output, output_);
+}
+
+TEST_F(StreamingDistillerTest, EmptyBody) {
+  DistillStreaming(std::string());
+  EXPECT_FALSE(distilled_);
+  EXPECT_TRUE(output_.empty());
+}
+
+// Checks that streaming holds less in memory than distilling the buffered
+// body, and gives the same output.
+TEST_F(StreamingDistillerTest, PeakMemory) {
+  const std::string body = MakeArticle(20000);
+
+  const std::string buffered = DistillBuffered(&speedreader_, body);
+  // The loader holds the whole body and the whole distilled page at once.
+  size_t buffered_peak = body.size() + buffered.size();
+
+  DistillStreaming(body);
+  EXPECT_EQ(buffered, output_);
+  EXPECT_LT(peak_buffered_bytes_, buffered_peak);
+}
+
+}  // namespace speedreader
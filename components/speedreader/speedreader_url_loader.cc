@@ -5,15 +5,19 @@
 
 #include "brave/components/speedreader/speedreader_url_loader.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
 
 #include "base/bind.h"
+#include "base/feature_list.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/task/post_task.h"
+#include "brave/components/speedreader/features.h"
 #include "brave/components/speedreader/rust/ffi/speedreader.h"
 #include "brave/components/speedreader/speedreader_rewriter_service.h"
+#include "brave/components/speedreader/speedreader_streaming_distiller.h"
 #include "brave/components/speedreader/speedreader_throttle.h"
 #include "mojo/public/cpp/bindings/self_owned_receiver.h"
 #include "services/network/public/mojom/url_response_head.mojom.h"
@@ -68,6 +72,7 @@ SpeedReaderURLLoader::SpeedReaderURLLoader(
       body_producer_watcher_(FROM_HERE,
                              mojo::SimpleWatcher::ArmingPolicy::MANUAL,
                              std::move(task_runner)),
+      distiller_(nullptr, base::OnTaskRunnerDeleter(nullptr)),
       rewriter_service_(rewriter_service) {}
 
 SpeedReaderURLLoader::~SpeedReaderURLLoader() = default;
@@ -118,7 +123,12 @@ void SpeedReaderURLLoader::OnStartLoadingResponseBody(
     mojo::ScopedDataPipeConsumerHandle body) {
   VLOG(2) << __func__ << " " << response_url_;
   state_ = State::kLoading;
+  body_start_time_ = base::TimeTicks::Now();
   body_consumer_handle_ = std::move(body);
+  if (base::FeatureList::IsEnabled(kSpeedreaderStreamingFeature) &&
+      rewriter_service_) {
+    StartStreamingDistiller();
+  }
   body_consumer_watcher_.Watch(
       body_consumer_handle_.get(),
       MOJO_HANDLE_SIGNAL_READABLE | MOJO_HANDLE_SIGNAL_PEER_CLOSED,
@@ -188,6 +198,10 @@ void SpeedReaderURLLoader::ResumeReadingBodyFromNet() {
 }
 
 void SpeedReaderURLLoader::OnBodyReadable(MojoResult) {
+  if (streaming_) {
+    StreamBodyToDistiller();
+    return;
+  }
   DCHECK_EQ(State::kLoading, state_);
 
   size_t start_size = buffered_body_.size();
@@ -213,21 +227,146 @@ void SpeedReaderURLLoader::OnBodyReadable(MojoResult) {
 
   DCHECK_EQ(MOJO_RESULT_OK, result);
   buffered_body_.resize(start_size + read_bytes);
-  // TODO(iefremov): We actually can partially |pumpContent| to speedreader,
-  // but skipping it for now to simplify things. Pumping is not free in terms
-  // of CPU ticks, so we will have to keep alive speedreader instance on another
-  // thread.
+  // See StreamBodyToDistiller() for partially pumping the body to
+  // speedreader.
 
   body_consumer_watcher_.ArmOrNotify();
 }
 
 void SpeedReaderURLLoader::OnBodyWritable(MojoResult r) {
   DCHECK_EQ(State::kSending, state_);
+  waiting_for_writable_ = false;
   if (bytes_remaining_in_buffer_ > 0) {
     SendReceivedBodyToClient();
-  } else {
+  } else if (!streaming_ || distiller_done_) {
     CompleteSending();
   }
+  // Otherwise wait for the distiller to produce more output.
+}
+
+void SpeedReaderURLLoader::StartStreamingDistiller() {
+  DCHECK(rewriter_service_);
+  streaming_ = true;
+  distiller_task_runner_ = base::CreateSequencedTaskRunner(
+      {base::ThreadPool(), base::TaskPriority::USER_BLOCKING});
+
+  // The distiller calls back on |distiller_task_runner_|.
+  auto output_callback = base::BindRepeating(
+      [](scoped_refptr<base::SingleThreadTaskRunner> task_runner,
+         base::WeakPtr<SpeedReaderURLLoader> loader, std::string output) {
+        task_runner->PostTask(
+            FROM_HERE,
+            base::BindOnce(&SpeedReaderURLLoader::OnDistilledOutput, loader,
+                           std::move(output)));
+      },
+      task_runner_, weak_factory_.GetWeakPtr());
+  auto done_callback = base::BindOnce(
+      [](scoped_refptr<base::SingleThreadTaskRunner> task_runner,
+         base::WeakPtr<SpeedReaderURLLoader> loader, bool distilled,
+         size_t peak_buffered_bytes) {
+        task_runner->PostTask(
+            FROM_HERE, base::BindOnce(&SpeedReaderURLLoader::OnDistillerDone,
+                                      loader, distilled, peak_buffered_bytes));
+      },
+      task_runner_, weak_factory_.GetWeakPtr());
+
+  distiller_ = std::unique_ptr<StreamingDistiller, base::OnTaskRunnerDeleter>(
+      new StreamingDistiller(rewriter_service_->GetContentStylesheet(),
+                             std::move(output_callback),
+                             std::move(done_callback)),
+      base::OnTaskRunnerDeleter(distiller_task_runner_));
+  distiller_->SetRewriter(rewriter_service_->MakeRewriter(
+      response_url_, &StreamingDistiller::OnRewriterOutput, distiller_.get()));
+}
+
+void SpeedReaderURLLoader::StreamBodyToDistiller() {
+  DCHECK(state_ == State::kLoading || state_ == State::kSending);
+  // The distiller may have given up before the whole body was read, see
+  // OnDistillerDone().
+  if (distiller_done_ || !distiller_)
+    return;
+
+  std::string chunk(kReadBufferSize, '\0');
+  uint32_t read_bytes = kReadBufferSize;
+  MojoResult result = body_consumer_handle_->ReadData(
+      &chunk[0], &read_bytes, MOJO_READ_DATA_FLAG_NONE);
+  switch (result) {
+    case MOJO_RESULT_OK:
+      break;
+    case MOJO_RESULT_FAILED_PRECONDITION:
+      // Reading is finished.
+      distiller_task_runner_->PostTask(
+          FROM_HERE, base::BindOnce(&StreamingDistiller::End,
+                                    base::Unretained(distiller_.get())));
+      return;
+    case MOJO_RESULT_SHOULD_WAIT:
+      body_consumer_watcher_.ArmOrNotify();
+      return;
+    default:
+      NOTREACHED();
+      return;
+  }
+
+  DCHECK_EQ(MOJO_RESULT_OK, result);
+  chunk.resize(read_bytes);
+  // |distiller_| is deleted on |distiller_task_runner_|, after this task.
+  distiller_task_runner_->PostTask(
+      FROM_HERE,
+      base::BindOnce(&StreamingDistiller::Write,
+                     base::Unretained(distiller_.get()), std::move(chunk)));
+  body_consumer_watcher_.ArmOrNotify();
+}
+
+void SpeedReaderURLLoader::OnDistilledOutput(std::string output) {
+  if (state_ != State::kLoading && state_ != State::kSending)
+    return;
+  if (output.empty())
+    return;
+
+  if (state_ == State::kLoading) {
+    if (!StartSendingToClient())
+      return;
+    buffered_body_ = std::move(output);
+  } else {
+    // Drop what has already been sent before queueing more.
+    buffered_body_.erase(0, buffered_body_.size() - bytes_remaining_in_buffer_);
+    buffered_body_.append(output);
+  }
+  bytes_remaining_in_buffer_ = buffered_body_.size();
+  peak_buffered_bytes_ = std::max(peak_buffered_bytes_, buffered_body_.size());
+
+  if (!waiting_for_writable_)
+    SendReceivedBodyToClient();
+}
+
+void SpeedReaderURLLoader::OnDistillerDone(bool distilled,
+                                           size_t peak_buffered_bytes) {
+  VLOG(2) << __func__ << " distilled = " << distilled;
+  distiller_done_ = true;
+  distiller_.reset();
+  // If the rewriter failed mid-stream the rest of the body is not needed, and
+  // there is no distiller left to write it to.
+  body_consumer_watcher_.Cancel();
+  UMA_HISTOGRAM_MEMORY_KB(
+      "Brave.Speedreader.PeakBufferedKB.Streaming",
+      (peak_buffered_bytes + peak_buffered_bytes_) / 1024);
+
+  switch (state_) {
+    case State::kLoading:
+      // Empty body.
+      if (!StartSendingToClient())
+        return;
+      CompleteSending();
+      return;
+    case State::kSending:
+      if (bytes_remaining_in_buffer_ == 0 && !waiting_for_writable_)
+        CompleteSending();
+      return;
+    case State::kWaitForBody:
+    case State::kCompleted:
+    case State::kAborted:
+      return;
+  }
 }
 
 void SpeedReaderURLLoader::MaybeLaunchSpeedreader() {
@@ -239,6 +378,7 @@ void SpeedReaderURLLoader::MaybeLaunchSpeedreader() {
 
   VLOG(2) << __func__ << " buffered body size = " << buffered_body_.size();
   bytes_remaining_in_buffer_ = buffered_body_.size();
+  peak_buffered_bytes_ = buffered_body_.size();
 
   if (bytes_remaining_in_buffer_ > 0) {
     // Offload heavy distilling to another thread.
@@ -277,16 +417,41 @@ void SpeedReaderURLLoader::MaybeLaunchSpeedreader() {
 }
 
 void SpeedReaderURLLoader::CompleteLoading(std::string body) {
+  DCHECK_EQ(State::kLoading, state_);
+  UMA_HISTOGRAM_MEMORY_KB("Brave.Speedreader.PeakBufferedKB.Buffered",
+                          (peak_buffered_bytes_ + body.size()) / 1024);
+
+  buffered_body_ = std::move(body);
+  bytes_remaining_in_buffer_ = buffered_body_.size();
+
+  if (!StartSendingToClient())
+    return;
+
+  DCHECK(bytes_remaining_in_buffer_);
+  if (bytes_remaining_in_buffer_) {
+    SendReceivedBodyToClient();
+    return;
+  }
+
+  CompleteSending();
+}
+
+bool SpeedReaderURLLoader::StartSendingToClient() {
   DCHECK_EQ(State::kLoading, state_);
   state_ = State::kSending;
 
   if (!throttle_) {
     Abort();
-    return;
+    return false;
   }
 
-  buffered_body_ = std::move(body);
-  bytes_remaining_in_buffer_ = buffered_body_.size();
+  if (streaming_) {
+    UMA_HISTOGRAM_TIMES("Brave.Speedreader.TimeToFirstByte.Streaming",
+                        base::TimeTicks::Now() - body_start_time_);
+  } else {
+    UMA_HISTOGRAM_TIMES("Brave.Speedreader.TimeToFirstByte.Buffered",
+                        base::TimeTicks::Now() - body_start_time_);
+  }
 
   throttle_->Resume();
   mojo::ScopedDataPipeConsumerHandle body_to_send;
@@ -294,7 +459,7 @@ void SpeedReaderURLLoader::CompleteLoading(std::string body) {
       mojo::CreateDataPipe(nullptr, &body_producer_handle_, &body_to_send);
   if (result != MOJO_RESULT_OK) {
     Abort();
-    return;
+    return false;
   }
   // Set up the watcher for the producer handle.
   body_producer_watcher_.Watch(
@@ -306,14 +471,7 @@ void SpeedReaderURLLoader::CompleteLoading(std::string body) {
   // Send deferred message.
   destination_url_loader_client_->OnStartLoadingResponseBody(
       std::move(body_to_send));
-
-  DCHECK(bytes_remaining_in_buffer_);
-  if (bytes_remaining_in_buffer_) {
-    SendReceivedBodyToClient();
-    return;
-  }
-
-  CompleteSending();
+  return true;
 }
 
 void SpeedReaderURLLoader::CompleteSending() {
@@ -348,6 +506,7 @@ void SpeedReaderURLLoader::SendReceivedBodyToClient() {
       Abort();
       return;
     case MOJO_RESULT_SHOULD_WAIT:
+      waiting_for_writable_ = true;
       body_producer_watcher_.ArmOrNotify();
       return;
     default:
@@ -355,6 +514,7 @@ void SpeedReaderURLLoader::SendReceivedBodyToClient() {
       return;
   }
   bytes_remaining_in_buffer_ -= bytes_sent;
+  waiting_for_writable_ = true;
   body_producer_watcher_.ArmOrNotify();
 }
 
@@ -363,6 +523,7 @@ void SpeedReaderURLLoader::Abort() {
   state_ = State::kAborted;
   body_consumer_watcher_.Cancel();
   body_producer_watcher_.Cancel();
+  distiller_.reset();
   source_url_loader_.reset();
   source_url_client_receiver_.reset();
   destination_url_loader_client_.reset();
@@ -6,6 +6,7 @@
 #ifndef BRAVE_COMPONENTS_SPEEDREADER_SPEEDREADER_URL_LOADER_H_
 #define BRAVE_COMPONENTS_SPEEDREADER_SPEEDREADER_URL_LOADER_H_
 
+#include <memory>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -13,7 +14,9 @@
 #include "base/callback.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
+#include "base/sequenced_task_runner.h"
 #include "base/strings/string_piece.h"
+#include "base/time/time.h"
 #include "mojo/public/cpp/bindings/binding.h"
 #include "mojo/public/cpp/bindings/pending_receiver.h"
 #include "mojo/public/cpp/bindings/pending_remote.h"
@@ -28,6 +31,7 @@ namespace speedreader {
 
 class SpeedReaderThrottle;
 class SpeedreaderRewriterService;
+class StreamingDistiller;
 
 // Loads the whole response body and tries to Speedreader-distill it.
 // Cargoculted from |`SniffingURLLoader|.
@@ -50,6 +54,12 @@ class SpeedreaderRewriterService;
 // kAborted: Unexpected behavior happens. Watchers, pipes and the binding from
 //           the source loader to |this| are stopped. All incoming messages from
 //           the destination (through network::mojom::URLLoader) are ignored in
+//
+// With kSpeedreaderStreamingFeature enabled, each chunk of the body is handed
+// to a StreamingDistiller as soon as it is read, and kLoading ends with the
+// first chunk of its output. The body keeps being read and distilled while
+// in kSending, and the state changes to kCompleted once the distiller is done
+// and all its output is sent.
 class SpeedReaderURLLoader : public network::mojom::URLLoaderClient,
                              public network::mojom::URLLoader {
  public:
@@ -114,8 +124,17 @@ class SpeedReaderURLLoader : public network::mojom::URLLoaderClient,
   void OnBodyWritable(MojoResult);
   void MaybeLaunchSpeedreader();
 
+  void StartStreamingDistiller();
+  void StreamBodyToDistiller();
+  // Gets each chunk of either distilled or untouched body from the distiller.
+  void OnDistilledOutput(std::string output);
+  void OnDistillerDone(bool distilled, size_t peak_buffered_bytes);
+
   // Gets either distilled or untouched body.
   void CompleteLoading(std::string body);
+  // Resumes the throttle and creates the pipe to the destination. Returns
+  // false if the loader had to be aborted.
+  bool StartSendingToClient();
   void CompleteSending();
   void SendReceivedBodyToClient();
 
@@ -140,7 +159,18 @@ class SpeedReaderURLLoader : public network::mojom::URLLoaderClient,
 
   // Note that this could be replaced by a distilled version.
   std::string buffered_body_;
-  size_t bytes_remaining_in_buffer_;
+  size_t bytes_remaining_in_buffer_ = 0;
+
+  // Only used in streaming mode.
+  bool streaming_ = false;
+  bool distiller_done_ = false;
+  // Whether |body_producer_watcher_| has been armed and not yet notified.
+  bool waiting_for_writable_ = false;
+  size_t peak_buffered_bytes_ = 0;
+  scoped_refptr<base::SequencedTaskRunner> distiller_task_runner_;
+  std::unique_ptr<StreamingDistiller, base::OnTaskRunnerDeleter> distiller_;
+
+  base::TimeTicks body_start_time_;
 
   mojo::ScopedDataPipeConsumerHandle body_consumer_handle_;
   mojo::ScopedDataPipeProducerHandle body_producer_handle_;
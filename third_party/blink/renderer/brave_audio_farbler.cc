@@ -0,0 +1,81 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/third_party/blink/renderer/brave_audio_farbler.h"
+
+#include "base/notreached.h"
+#include "brave/third_party/blink/renderer/brave_farbling_utils.h"
+
+namespace {
+
+// Returns a pseudo-random float between 0 and 0.1.
+inline float PseudoRandomSample(uint64_t state) {
+  const double kMaxUInt64AsDouble = UINT64_MAX;
+  return (state / kMaxUInt64AsDouble) / 10;
+}
+
+}  // namespace
+
+namespace brave {
+
+// static
+AudioFarbler AudioFarbler::ConstantMultiplier(double fudge_factor) {
+  AudioFarbler farbler;
+  farbler.mode_ = Mode::kConstantMultiplier;
+  farbler.fudge_factor_ = fudge_factor;
+  return farbler;
+}
+
+// static
+AudioFarbler AudioFarbler::PseudoRandomSequence(uint64_t seed) {
+  AudioFarbler farbler;
+  farbler.mode_ = Mode::kPseudoRandomSequence;
+  farbler.seed_ = seed;
+  farbler.state_ = seed;
+  return farbler;
+}
+
+float AudioFarbler::FarbleSample(float value, size_t index) {
+  switch (mode_) {
+    case Mode::kIdentity:
+      return value;
+    case Mode::kConstantMultiplier:
+      return value * fudge_factor_;
+    case Mode::kPseudoRandomSequence:
+      if (index == 0)
+        state_ = seed_;
+      state_ = lfsr_next(state_);
+      return PseudoRandomSample(state_);
+  }
+  NOTREACHED();
+  return value;
+}
+
+void AudioFarbler::FarbleSamples(float* samples, size_t count) {
+  switch (mode_) {
+    case Mode::kIdentity:
+      return;
+    case Mode::kConstantMultiplier: {
+      // Multiplied as doubles, like FarbleSample().
+      const double fudge_factor = fudge_factor_;
+      for (size_t i = 0; i < count; ++i)
+        samples[i] = samples[i] * fudge_factor;
+      return;
+    }
+    case Mode::kPseudoRandomSequence: {
+      if (count == 0)
+        return;
+      uint64_t state = seed_;
+      for (size_t i = 0; i < count; ++i) {
+        state = lfsr_next(state);
+        samples[i] = PseudoRandomSample(state);
+      }
+      state_ = state;
+      return;
+    }
+  }
+}
+
+}  // namespace brave
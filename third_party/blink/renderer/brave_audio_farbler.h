@@ -0,0 +1,48 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_AUDIO_FARBLER_H_
+#define BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_AUDIO_FARBLER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace brave {
+
+// Farbles audio samples read by scripts. A default constructed farbler leaves
+// samples untouched.
+class AudioFarbler {
+ public:
+  AudioFarbler() = default;
+
+  // Multiplies every sample by |fudge_factor|.
+  static AudioFarbler ConstantMultiplier(double fudge_factor);
+  // Replaces every sample with the next value, between 0 and 0.1, of a
+  // pseudo-random sequence that restarts from |seed| at index 0.
+  static AudioFarbler PseudoRandomSequence(uint64_t seed);
+
+  bool is_identity() const { return mode_ == Mode::kIdentity; }
+
+  // Farbles the sample at |index| of a buffer that is read in order from
+  // index 0.
+  float FarbleSample(float value, size_t index);
+
+  // Farbles |count| samples in place. The result is the same as calling
+  // FarbleSample() for each index from 0, but the loops are simple enough for
+  // the compiler to vectorize the multiplication.
+  void FarbleSamples(float* samples, size_t count);
+
+ private:
+  enum class Mode { kIdentity, kConstantMultiplier, kPseudoRandomSequence };
+
+  Mode mode_ = Mode::kIdentity;
+  double fudge_factor_ = 1;
+  uint64_t seed_ = 0;
+  uint64_t state_ = 0;
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_AUDIO_FARBLER_H_
@@ -0,0 +1,100 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/third_party/blink/renderer/brave_audio_farbler.h"
+
+#include <vector>
+
+#include "base/bind.h"
+#include "base/callback.h"
+#include "brave/third_party/blink/renderer/brave_farbling_utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave {
+
+namespace {
+
+// Ten seconds of audio at 48kHz.
+const size_t kSampleCount = 10 * 48000;
+const double kFudgeFactor = 0.9953;
+const uint64_t kSeed = 0x1234567890abcdefULL;
+
+// The per-sample callbacks farbling used to be run through.
+float ConstantMultiplier(double fudge_factor, float value, size_t index) {
+  return value * fudge_factor;
+}
+
+float PseudoRandomSequence(uint64_t seed, float value, size_t index) {
+  static uint64_t v;
+  const double maxUInt64AsDouble = UINT64_MAX;
+  if (index == 0)
+    v = seed;
+  v = lfsr_next(v);
+  return (v / maxUInt64AsDouble) / 10;
+}
+
+std::vector<float> MakeSamples() {
+  std::vector<float> samples(kSampleCount);
+  for (size_t i = 0; i < samples.size(); ++i)
+    samples[i] = static_cast<float>(i % 2000) / 1000 - 1;
+  return samples;
+}
+
+void CompareWithCallback(
+    AudioFarbler farbler,
+    base::RepeatingCallback<float(float, size_t)> callback) {
+  std::vector<float> expected = MakeSamples();
+  for (size_t i = 0; i < expected.size(); ++i)
+    expected[i] = callback.Run(expected[i], i);
+
+  std::vector<float> farbled = MakeSamples();
+  farbler.FarbleSamples(farbled.data(), farbled.size());
+  EXPECT_EQ(expected, farbled);
+
+  std::vector<float> single = MakeSamples();
+  for (size_t i = 0; i < single.size(); ++i)
+    single[i] = farbler.FarbleSample(single[i], i);
+  EXPECT_EQ(expected, single);
+}
+
+}  // namespace
+
+TEST(AudioFarblerTest, IdentityLeavesSamples) {
+  AudioFarbler farbler;
+  EXPECT_TRUE(farbler.is_identity());
+  std::vector<float> samples = MakeSamples();
+  farbler.FarbleSamples(samples.data(), samples.size());
+  EXPECT_EQ(MakeSamples(), samples);
+  EXPECT_EQ(0.5f, farbler.FarbleSample(0.5f, 3));
+}
+
+TEST(AudioFarblerTest, ConstantMultiplierMatchesCallback) {
+  AudioFarbler farbler = AudioFarbler::ConstantMultiplier(kFudgeFactor);
+  EXPECT_FALSE(farbler.is_identity());
+  CompareWithCallback(farbler,
+                      base::BindRepeating(&ConstantMultiplier, kFudgeFactor));
+}
+
+TEST(AudioFarblerTest, PseudoRandomSequenceMatchesCallback) {
+  AudioFarbler farbler = AudioFarbler::PseudoRandomSequence(kSeed);
+  EXPECT_FALSE(farbler.is_identity());
+  CompareWithCallback(farbler,
+                      base::BindRepeating(&PseudoRandomSequence, kSeed));
+}
+
+TEST(AudioFarblerTest, PseudoRandomSequenceRestartsAtIndexZero) {
+  AudioFarbler farbler = AudioFarbler::PseudoRandomSequence(kSeed);
+  float first = farbler.FarbleSample(0, 0);
+  float second = farbler.FarbleSample(0, 1);
+  EXPECT_NE(first, second);
+  EXPECT_EQ(first, farbler.FarbleSample(0, 0));
+
+  std::vector<float> samples(2);
+  farbler.FarbleSamples(samples.data(), samples.size());
+  farbler.FarbleSamples(samples.data(), samples.size());
+  EXPECT_EQ(std::vector<float>({first, second}), samples);
+}
+
+}  // namespace brave
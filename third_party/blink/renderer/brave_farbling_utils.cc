@@ -0,0 +1,78 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/third_party/blink/renderer/brave_farbling_utils.h"
+
+#include <string.h>
+
+#include "base/check_op.h"
+
+namespace brave {
+
+void PerturbCanvasPixels(uint8_t* pixels,
+                         size_t pixel_count,
+                         uint8_t channel,
+                         const uint8_t canvas_key[kCanvasKeySize]) {
+  if (pixel_count == 0)
+    return;
+  uint64_t v;
+  memcpy(&v, canvas_key, sizeof(v));
+  uint64_t pixel_index;
+  // iterate through 32-byte canvas key and use each bit to determine how to
+  // perturb the current pixel
+  for (size_t i = 0; i < kCanvasKeySize; i++) {
+    uint8_t bit = canvas_key[i];
+    for (int j = 8; j >= 0; j--) {
+      pixel_index = 4 * (v % pixel_count) + channel;
+      pixels[pixel_index] = pixels[pixel_index] ^ (bit & 0x1);
+      bit = bit >> 1;
+      // find next pixel to perturb
+      v = lfsr_next(v);
+    }
+  }
+}
+
+constexpr size_t CanvasKeyCache::kMaxSize;
+
+bool CanvasKeyCache::Get(uint32_t image_id,
+                         uint8_t canvas_key[kCanvasKeySize]) {
+  if (image_id == 0)
+    return false;
+  for (size_t i = 0; i < size_; ++i) {
+    if (entries_[i].image_id != image_id)
+      continue;
+    MoveToFront(i);
+    memcpy(canvas_key, entries_[0].canvas_key, kCanvasKeySize);
+    return true;
+  }
+  return false;
+}
+
+void CanvasKeyCache::Put(uint32_t image_id,
+                         const uint8_t canvas_key[kCanvasKeySize]) {
+  if (image_id == 0)
+    return;
+  size_t index = 0;
+  while (index < size_ && entries_[index].image_id != image_id)
+    ++index;
+  if (index == size_) {
+    // Not cached, so reuse the least recently used entry if full.
+    if (size_ < kMaxSize)
+      ++size_;
+    index = size_ - 1;
+    entries_[index].image_id = image_id;
+  }
+  memcpy(entries_[index].canvas_key, canvas_key, kCanvasKeySize);
+  MoveToFront(index);
+}
+
+void CanvasKeyCache::MoveToFront(size_t index) {
+  DCHECK_LT(index, size_);
+  const Entry entry = entries_[index];
+  memmove(&entries_[1], &entries_[0], index * sizeof(Entry));
+  entries_[0] = entry;
+}
+
+}  // namespace brave
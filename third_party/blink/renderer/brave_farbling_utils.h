@@ -0,0 +1,68 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_FARBLING_UTILS_H_
+#define BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_FARBLING_UTILS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace brave {
+
+// Advances the 64-bit LFSR that farbling uses as a cheap, seeded source of
+// pseudo-random values.
+inline uint64_t lfsr_next(uint64_t v) {
+  const uint64_t zero = 0;
+  return ((v >> 1) | (((v << 62) ^ (v << 61)) & (~(~zero << 63) << 62)));
+}
+
+// Size of the HMAC-SHA256 key that selects which pixels to perturb.
+constexpr size_t kCanvasKeySize = 32;
+
+// Flips the low bit of |channel| in pixels of an RGBA buffer, choosing the
+// pixels and the bits with |canvas_key|.
+void PerturbCanvasPixels(uint8_t* pixels,
+                         size_t pixel_count,
+                         uint8_t channel,
+                         const uint8_t canvas_key[kCanvasKeySize]);
+
+// Remembers the canvas keys of recently farbled canvas snapshots, so that
+// reading an unchanged canvas again doesn't sign its pixels again. Snapshots
+// are identified by the unique ID of their SkImage, which changes whenever the
+// canvas is drawn to. Only the keys are kept, so the cache stays small however
+// large the canvases are.
+class CanvasKeyCache {
+ public:
+  static constexpr size_t kMaxSize = 8;
+
+  CanvasKeyCache() = default;
+  CanvasKeyCache(const CanvasKeyCache&) = delete;
+  CanvasKeyCache& operator=(const CanvasKeyCache&) = delete;
+
+  // Copies the key of |image_id| to |canvas_key| and makes it the most
+  // recently used. Returns false if |image_id| is not cached.
+  bool Get(uint32_t image_id, uint8_t canvas_key[kCanvasKeySize]);
+  // Adds the key of |image_id|, evicting the least recently used key if the
+  // cache is full. An |image_id| of 0 is never cached.
+  void Put(uint32_t image_id, const uint8_t canvas_key[kCanvasKeySize]);
+
+  size_t size() const { return size_; }
+
+ private:
+  struct Entry {
+    uint32_t image_id;
+    uint8_t canvas_key[kCanvasKeySize];
+  };
+
+  void MoveToFront(size_t index);
+
+  // Most recently used first.
+  Entry entries_[kMaxSize];
+  size_t size_ = 0;
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_FARBLING_UTILS_H_
@@ -0,0 +1,163 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/third_party/blink/renderer/brave_farbling_utils.h"
+
+#include <string.h>
+
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave {
+
+namespace {
+
+std::vector<uint8_t> MakePixels(size_t pixel_count) {
+  std::vector<uint8_t> pixels(4 * pixel_count);
+  for (size_t i = 0; i < pixels.size(); ++i)
+    pixels[i] = static_cast<uint8_t>(i * 31 + i / 4096);
+  return pixels;
+}
+
+void MakeCanvasKey(uint8_t seed, uint8_t canvas_key[kCanvasKeySize]) {
+  for (size_t i = 0; i < kCanvasKeySize; ++i)
+    canvas_key[i] = static_cast<uint8_t>(seed * 37 + i * 101);
+}
+
+bool HasCanvasKey(CanvasKeyCache* cache, uint32_t image_id, uint8_t seed) {
+  uint8_t expected[kCanvasKeySize];
+  MakeCanvasKey(seed, expected);
+  uint8_t canvas_key[kCanvasKeySize];
+  return cache->Get(image_id, canvas_key) &&
+         memcmp(expected, canvas_key, kCanvasKeySize) == 0;
+}
+
+void PutCanvasKey(CanvasKeyCache* cache, uint32_t image_id, uint8_t seed) {
+  uint8_t canvas_key[kCanvasKeySize];
+  MakeCanvasKey(seed, canvas_key);
+  cache->Put(image_id, canvas_key);
+}
+
+}  // namespace
+
+TEST(BraveFarblingUtilsTest, PerturbCanvasPixelsOnlyChangesLowBitOfChannel) {
+  const size_t pixel_count = 64 * 64;
+  std::vector<uint8_t> pixels = MakePixels(pixel_count);
+  uint8_t canvas_key[kCanvasKeySize];
+  MakeCanvasKey(1, canvas_key);
+
+  PerturbCanvasPixels(pixels.data(), pixel_count, 1, canvas_key);
+
+  const std::vector<uint8_t> original = MakePixels(pixel_count);
+  EXPECT_NE(original, pixels);
+  for (size_t i = 0; i < pixels.size(); ++i) {
+    if (i % 4 != 1)
+      EXPECT_EQ(original[i], pixels[i]);
+    else
+      EXPECT_EQ(original[i] & ~1, pixels[i] & ~1);
+  }
+}
+
+TEST(BraveFarblingUtilsTest, PerturbCanvasPixelsDependsOnlyOnKey) {
+  const size_t pixel_count = 64 * 64;
+  uint8_t canvas_key[kCanvasKeySize];
+  MakeCanvasKey(1, canvas_key);
+
+  std::vector<uint8_t> pixels = MakePixels(pixel_count);
+  PerturbCanvasPixels(pixels.data(), pixel_count, 2, canvas_key);
+  std::vector<uint8_t> same_key_pixels = MakePixels(pixel_count);
+  PerturbCanvasPixels(same_key_pixels.data(), pixel_count, 2, canvas_key);
+  EXPECT_EQ(pixels, same_key_pixels);
+
+  // The same bits are flipped again, which restores the original pixels.
+  PerturbCanvasPixels(pixels.data(), pixel_count, 2, canvas_key);
+  EXPECT_EQ(MakePixels(pixel_count), pixels);
+
+  uint8_t other_canvas_key[kCanvasKeySize];
+  MakeCanvasKey(2, other_canvas_key);
+  std::vector<uint8_t> other_key_pixels = MakePixels(pixel_count);
+  PerturbCanvasPixels(other_key_pixels.data(), pixel_count, 2,
+                      other_canvas_key);
+  EXPECT_NE(same_key_pixels, other_key_pixels);
+}
+
+TEST(BraveFarblingUtilsTest, PerturbEmptyCanvas) {
+  uint8_t canvas_key[kCanvasKeySize];
+  MakeCanvasKey(1, canvas_key);
+  PerturbCanvasPixels(nullptr, 0, 0, canvas_key);
+}
+
+TEST(BraveFarblingUtilsTest, CanvasKeyCacheHitsSameImage) {
+  CanvasKeyCache cache;
+  PutCanvasKey(&cache, 1, 1);
+
+  EXPECT_TRUE(HasCanvasKey(&cache, 1, 1));
+  EXPECT_TRUE(HasCanvasKey(&cache, 1, 1));
+  EXPECT_EQ(1u, cache.size());
+}
+
+TEST(BraveFarblingUtilsTest, CanvasKeyCacheMissesChangedImage) {
+  CanvasKeyCache cache;
+  PutCanvasKey(&cache, 1, 1);
+
+  // Drawing to the canvas gives its snapshot a new image ID.
+  uint8_t canvas_key[kCanvasKeySize];
+  EXPECT_FALSE(cache.Get(2, canvas_key));
+
+  PutCanvasKey(&cache, 2, 2);
+  EXPECT_TRUE(HasCanvasKey(&cache, 2, 2));
+  EXPECT_TRUE(HasCanvasKey(&cache, 1, 1));
+}
+
+TEST(BraveFarblingUtilsTest, CanvasKeyCacheDoesNotCacheImagesWithoutID) {
+  CanvasKeyCache cache;
+  PutCanvasKey(&cache, 0, 1);
+
+  uint8_t canvas_key[kCanvasKeySize];
+  EXPECT_FALSE(cache.Get(0, canvas_key));
+  EXPECT_EQ(0u, cache.size());
+}
+
+TEST(BraveFarblingUtilsTest, CanvasKeyCacheUpdatesExistingImage) {
+  CanvasKeyCache cache;
+  PutCanvasKey(&cache, 1, 1);
+  PutCanvasKey(&cache, 1, 2);
+
+  EXPECT_TRUE(HasCanvasKey(&cache, 1, 2));
+  EXPECT_EQ(1u, cache.size());
+}
+
+TEST(BraveFarblingUtilsTest, CanvasKeyCacheEvictsLeastRecentlyUsed) {
+  CanvasKeyCache cache;
+  for (uint32_t id = 1; id <= CanvasKeyCache::kMaxSize; ++id)
+    PutCanvasKey(&cache, id, id);
+  EXPECT_EQ(CanvasKeyCache::kMaxSize, cache.size());
+
+  PutCanvasKey(&cache, CanvasKeyCache::kMaxSize + 1, 0);
+
+  EXPECT_EQ(CanvasKeyCache::kMaxSize, cache.size());
+  uint8_t canvas_key[kCanvasKeySize];
+  EXPECT_FALSE(cache.Get(1, canvas_key));
+  for (uint32_t id = 2; id <= CanvasKeyCache::kMaxSize; ++id)
+    EXPECT_TRUE(HasCanvasKey(&cache, id, id));
+  EXPECT_TRUE(HasCanvasKey(&cache, CanvasKeyCache::kMaxSize + 1, 0));
+}
+
+TEST(BraveFarblingUtilsTest, CanvasKeyCacheGetMakesMostRecentlyUsed) {
+  CanvasKeyCache cache;
+  for (uint32_t id = 1; id <= CanvasKeyCache::kMaxSize; ++id)
+    PutCanvasKey(&cache, id, id);
+
+  // Reading the oldest image keeps it, so the next oldest is evicted instead.
+  EXPECT_TRUE(HasCanvasKey(&cache, 1, 1));
+  PutCanvasKey(&cache, CanvasKeyCache::kMaxSize + 1, 0);
+
+  uint8_t canvas_key[kCanvasKeySize];
+  EXPECT_TRUE(HasCanvasKey(&cache, 1, 1));
+  EXPECT_FALSE(cache.Get(2, canvas_key));
+}
+
+}  // namespace brave